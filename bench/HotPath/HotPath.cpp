@@ -0,0 +1,228 @@
+#include <Authorization.h>
+#include <CableTypeStore.h>
+#include <Compression.h>
+#include <DefaultCableType.h>
+#include <IdentifierIndex.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <Responses.h>
+#include <Validation.h>
+#include <atomic>
+#include <cstdlib>
+
+/*
+ * Micro benchmarks of helpers used on API Mock request path.
+ * Reports nanoseconds and heap allocations per operation as JSON.
+ */
+
+namespace {
+  std::atomic<quint64> allocations = 0;
+} // namespace
+
+#if defined(__GLIBC__)
+/*
+ * Every heap allocation, including ones made by Qt containers,
+ * goes through malloc, so it is interposed to count them.
+ */
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* pointer, std::size_t size);
+
+void* malloc(std::size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, std::size_t size) noexcept {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(pointer, size);
+}
+}
+static constexpr bool allocationsCounted = true;
+#else
+static constexpr bool allocationsCounted = false;
+#endif
+
+namespace {
+  template <typename T>
+  void keep(T&& value) {
+    __asm__ volatile("" : : "g"(&value) : "memory");
+  }
+
+  class Benchmark {
+
+  public:
+    explicit Benchmark(qint64 minimumTimeNs)
+      : m_minimumTimeNs(minimumTimeNs) { }
+
+    template <typename Operation>
+    void run(const char* name, Operation&& operation) {
+      static constexpr int warmUpIterations = 1000;
+      for (int i = 0; i < warmUpIterations; ++i) {
+        keep(operation());
+      }
+
+      auto allocationsBefore = allocations.load();
+      for (int i = 0; i < warmUpIterations; ++i) {
+        keep(operation());
+      }
+      auto allocationsPerOp =
+          static_cast<double>(allocations.load() - allocationsBefore) /
+          warmUpIterations;
+
+      qint64 iterations = warmUpIterations;
+      qint64 elapsedNs = 0;
+      while (true) {
+        QElapsedTimer timer;
+        timer.start();
+        for (qint64 i = 0; i < iterations; ++i) {
+          keep(operation());
+        }
+        elapsedNs = timer.nsecsElapsed();
+        if (elapsedNs >= m_minimumTimeNs) {
+          break;
+        }
+        iterations *= 2;
+      }
+
+      QJsonObject result;
+      result["name"] = name;
+      result["iterations"] = iterations;
+      result["nsPerOp"] = static_cast<double>(elapsedNs) / iterations;
+      result["allocationsPerOp"] =
+          allocationsCounted ? QJsonValue(allocationsPerOp) : QJsonValue();
+      m_results.append(result);
+    }
+
+    const QJsonArray& results() const noexcept {
+      return m_results;
+    }
+
+  private:
+    qint64 m_minimumTimeNs;
+    QJsonArray m_results;
+  };
+} // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Micro benchmarks of API Mock request path helpers");
+  parser.addHelpOption();
+  QCommandLineOption minimumTimeOption(
+      "min-time", "Minimum measured time of each benchmark.", "ms", "200");
+  QCommandLineOption outputOption(
+      "output", "Write JSON results to file instead of stdout.", "path");
+  QCommandLineOption identifiersOption(
+      "identifiers",
+      "Count of identifiers to complete prefixes of.",
+      "count",
+      "1000000");
+  parser.addOptions({ minimumTimeOption, outputOption, identifiersOption });
+  parser.process(application);
+
+  Benchmark benchmark(parser.value(minimumTimeOption).toLongLong() *
+                      1'000'000);
+
+  using namespace test::api;
+
+  QString validUnit{ "m" };
+  QString invalidUnit{ "g" };
+  benchmark.run("validateRotationFrequencyUnitValues/valid", [&] {
+    return validateRotationFrequencyUnitValues(QString(validUnit));
+  });
+  benchmark.run("validateRotationFrequencyUnitValues/invalid", [&] {
+    return validateRotationFrequencyUnitValues(QString(invalidUnit));
+  });
+
+  // Token of request is resolved to role instead of header extraction
+  auto superuserToken = tokenOf("superuser").toUtf8();
+  QByteArray unknownToken{ "unknown" };
+  QByteArray noToken;
+  benchmark.run("resolveRole/superuser",
+                [&] { return resolveRole(superuserToken); });
+  benchmark.run("resolveRole/unknown",
+                [&] { return resolveRole(unknownToken); });
+  benchmark.run("resolveRole/anonymous", [&] { return resolveRole(noToken); });
+
+  benchmark.run("makeResponse/NotFoundById",
+                [] { return makeResponse(Error::NotFoundById); });
+  benchmark.run("responseByState/DatabaseConnectionError", [] {
+    return responseByState(MockApiServer::State::DatabaseConnectionError);
+  });
+
+  benchmark.run("QJsonDocument::fromJson/defaultCableTypeData", [] {
+    return QJsonDocument::fromJson(defaultCableTypeData);
+  });
+
+  auto cableType = QJsonDocument::fromJson(defaultCableTypeData).object();
+  benchmark.run("QHttpServerResponse/cableType",
+                [&] { return QHttpServerResponse(cableType); });
+
+  CableTypeStore store;
+  store.insert(cableType);
+  auto id = cableType["id"].toString();
+  auto identifier = cableType["identifier"].toString();
+  auto customerCode = cableType["customer"].toObject()["code"].toString();
+  benchmark.run("CableTypeStore::findById",
+                [&] { return store.findById(id); });
+  benchmark.run("CableTypeStore::findByIdentifierAndCustomerCode", [&] {
+    return store.findByIdentifierAndCustomerCode(identifier, customerCode);
+  });
+
+  // Stored cable type is compressed once, later responses reuse it
+  auto stored = store.findById(id);
+  benchmark.run("encode/gzip", [&] {
+    return encode(stored->json(), ContentEncoding::Gzip);
+  });
+  benchmark.run("StoredCableType::encoded/gzip",
+                [&] { return stored->encoded(ContentEncoding::Gzip); });
+
+  // Identifiers as in catalogs, e.g. "10-al-1c-trxple"
+  IdentifierIndex identifiers;
+  static const QString materials[] = { "al", "cu" };
+  static const QString insulations[] = { "trxple", "xlpe", "pvc", "epr" };
+  auto identifierCount = parser.value(identifiersOption).toLongLong();
+  for (qint64 i = 0; i < identifierCount; ++i) {
+    identifiers.add(QString("%1-%2-%3c-%4-%5")
+                        .arg(i % 1000)
+                        .arg(materials[i % 2])
+                        .arg(1 + i / 1000 % 4)
+                        .arg(insulations[i / 4000 % 4])
+                        .arg(i / 16000));
+  }
+  QString prefix{ "10-al-1c-trxple" };
+  QString typo{ "10-la-1c-trxple" };
+  benchmark.run("IdentifierIndex::complete/prefix",
+                [&] { return identifiers.complete(prefix, 10, false); });
+  benchmark.run("IdentifierIndex::complete/typos",
+                [&] { return identifiers.complete(typo, 10, true); });
+
+  auto json = QJsonDocument(benchmark.results()).toJson();
+  QFile output;
+  if (parser.isSet(outputOption)) {
+    output.setFileName(parser.value(outputOption));
+    if (not output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qCritical() << "Failed to open" << output.fileName();
+      return 1;
+    }
+  } else if (not output.open(stdout, QIODevice::WriteOnly)) {
+    return 1;
+  }
+  output.write(json);
+
+  return 0;
+}
@@ -0,0 +1,374 @@
+#include <Metrics.h>
+#include <MockApiServer.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QThread>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <utils.h>
+#include <vector>
+
+/*
+ * Closed loop throughput benchmark of API Mock routes.
+ * Every client sends next request only after response to previous one,
+ * clients run on their own threads with their own connections.
+ * Results are printed as JSON.
+ */
+
+namespace {
+  using State = test::api::MockApiServer::State;
+
+  static constexpr std::pair<State, const char*> states[] = {
+    { State::Normal, "Normal" },
+    { State::Unauthorized, "Unauthorized" },
+    { State::AttemptToAccessAnotherCustomerData,
+      "AttemptToAccessAnotherCustomerData" },
+    { State::NonExistingCustomerId, "NonExistingCustomerId" },
+    { State::CableTypeAlreadyExists, "CableTypeAlreadyExists" },
+    { State::BusinessRulesViolated, "BusinessRulesViolated" },
+    { State::DatabaseRejectedTransaction, "DatabaseRejectedTransaction" },
+    { State::DatabaseUnhandledError, "DatabaseUnhandledError" },
+    { State::DatabaseRequestTimeout, "DatabaseRequestTimeout" },
+    { State::DatabaseConnectionError, "DatabaseConnectionError" },
+    { State::TooLargePayload, "TooLargePayload" },
+    { State::CableTypeReferencedByOtherEntities,
+      "CableTypeReferencedByOtherEntities" },
+  };
+
+  struct Context {
+    QUrl baseUrl;
+    QByteArray token;
+    QJsonObject cableType;
+    QByteArray etag;
+  };
+
+  struct Route {
+    const char* name;
+
+    /*
+     * Route as API Mock counts it in its metrics.
+     */
+    const char* servedRoute;
+    std::function<test::utils::Request(const Context&)> makeRequest;
+  };
+
+  QNetworkRequest makeNetworkRequest(const Context& context,
+                                     const QString& path) {
+    QNetworkRequest request(QUrl(context.baseUrl.toString() + path));
+    request.setRawHeader("Authorization", context.token);
+    request.setHeader(QNetworkRequest::ContentTypeHeader,
+                      QString("application/json"));
+    return request;
+  }
+
+  QString idOf(const Context& context) {
+    return context.cableType["id"].toString();
+  }
+
+  QString identifierOf(const Context& context) {
+    return context.cableType["identifier"].toString();
+  }
+
+  QString catIdOf(const Context& context) {
+    return QString::number(context.cableType["catid"].toInt());
+  }
+
+  QString customerCodeOf(const Context& context) {
+    return context.cableType["customer"].toObject()["code"].toString();
+  }
+
+  /*
+   * DELETE removes the only stored cable type,
+   * so all but first DELETE requests measure not found path.
+   */
+  const std::vector<Route>& routes() {
+    static const std::vector<Route> definitions = {
+      { "POST /cable/type",
+        "POST /cable/type",
+       [](const Context& context) -> test::utils::Request {
+         auto cableType = context.cableType;
+         cableType.remove("id");
+         return { "POST",
+                  makeNetworkRequest(context, "/cable/type"),
+                  QJsonDocument(cableType).toJson() };
+       } },
+      { "GET /cable/type/id/<id>",
+        "GET /cable/type/id/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "GET",
+                  makeNetworkRequest(context,
+                                     "/cable/type/id/" + idOf(context)) };
+       } },
+      { "GET /cable/type/id/<id> If-None-Match",
+        "GET /cable/type/id/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         auto request =
+             makeNetworkRequest(context, "/cable/type/id/" + idOf(context));
+         request.setRawHeader("If-None-Match", context.etag);
+         return { "GET", request };
+       } },
+      { "PUT /cable/type/id/<id>",
+        "PUT /cable/type/id/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "PUT",
+                  makeNetworkRequest(context,
+                                     "/cable/type/id/" + idOf(context)),
+                  QJsonDocument(context.cableType).toJson() };
+       } },
+      { "DELETE /cable/type/id/<id>",
+        "DELETE /cable/type/id/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "DELETE",
+                  makeNetworkRequest(context,
+                                     "/cable/type/id/" + idOf(context)) };
+       } },
+      { "GET /cable/type/identifier/<identifier>",
+        "GET /cable/type/identifier/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "GET",
+                  makeNetworkRequest(context,
+                                     "/cable/type/identifier/" +
+                                         identifierOf(context)) };
+       } },
+      { "GET /cable/type/catid/<catid>",
+        "GET /cable/type/catid/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "GET",
+                  makeNetworkRequest(context,
+                                     "/cable/type/catid/" + catIdOf(context)) };
+       } },
+      { "GET /cable/type/identifier/<identifier>/customer/code/<code>",
+        "GET /cable/type/identifier/<arg>/customer/code/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "GET",
+                  makeNetworkRequest(context,
+                                     "/cable/type/identifier/" +
+                                         identifierOf(context) +
+                                         "/customer/code/" +
+                                         customerCodeOf(context)) };
+       } },
+      { "GET /cable/type/catid/<catid>/customer/code/<code>",
+        "GET /cable/type/catid/<arg>/customer/code/<arg>",
+       [](const Context& context) -> test::utils::Request {
+         return { "GET",
+                  makeNetworkRequest(context,
+                                     "/cable/type/catid/" + catIdOf(context) +
+                                         "/customer/code/" +
+                                         customerCodeOf(context)) };
+       } },
+    };
+    return definitions;
+  }
+
+  struct Measurement {
+    std::vector<qint64> latencies;
+    quint64 transportErrors = 0;
+    quint64 bodyBytes = 0;
+  };
+
+  Measurement runClient(const test::utils::Request& request,
+                        bool compression,
+                        std::chrono::milliseconds duration) {
+    test::utils::Client client{ test::utils::Client::Options{
+        .compression = compression } };
+    Measurement measurement;
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (elapsed.elapsed() < duration.count()) {
+      QElapsedTimer latency;
+      latency.start();
+      auto response = test::utils::sendRequest(client, request);
+      auto [body, statusCode, error] =
+          test::utils::waitForResults(response).front();
+      measurement.latencies.push_back(latency.nsecsElapsed());
+
+      // Responses with error status are expected, only lost ones are counted
+      if (0 == statusCode) {
+        ++measurement.transportErrors;
+      }
+    }
+    measurement.bodyBytes = client.bodyBytesReceived();
+
+    return measurement;
+  }
+
+  double percentile(const std::vector<qint64>& sortedLatencies,
+                    double fraction) {
+    if (sortedLatencies.empty()) {
+      return 0.0;
+    }
+    auto index = std::min(
+        sortedLatencies.size() - 1,
+        static_cast<std::size_t>(fraction * sortedLatencies.size()));
+    return sortedLatencies[index] / 1000.0;
+  }
+
+  QJsonObject measure(const Route& route,
+                      State state,
+                      const QString& stateName,
+                      std::size_t clients,
+                      std::size_t workers,
+                      bool compression,
+                      std::chrono::milliseconds duration) {
+    test::api::MockApiServer apiServer{
+      state,
+      test::api::MockApiServer::Options{ .workerThreads = workers }
+    };
+
+    Context context;
+    context.baseUrl = apiServer.url();
+    context.token =
+        test::utils::loginUser(apiServer.url(), "superuser").toUtf8();
+    auto stored = apiServer.store().findByIdentifier("10-al-1c-trxple");
+    context.cableType = stored->cableType();
+    context.etag = stored->etag(test::api::ContentEncoding::Identity);
+    auto request = route.makeRequest(context);
+
+    std::vector<Measurement> measurements(clients);
+    std::vector<std::unique_ptr<QThread>> threads;
+    QEventLoop loop;
+    auto running = clients;
+
+    QElapsedTimer wallTime;
+    wallTime.start();
+    for (std::size_t i = 0; i < clients; ++i) {
+      threads.emplace_back(
+          QThread::create([&measurements, &request, i, compression, duration] {
+            measurements[i] = runClient(request, compression, duration);
+          }));
+      QObject::connect(threads.back().get(), &QThread::finished, &loop, [&] {
+        if (0 == --running) {
+          loop.quit();
+        }
+      });
+      threads.back()->start();
+    }
+    loop.exec();
+    auto wallSeconds = wallTime.nsecsElapsed() / 1e9;
+
+    std::vector<qint64> latencies;
+    quint64 transportErrors = 0;
+    quint64 bodyBytes = 0;
+    for (auto& measurement : measurements) {
+      latencies.insert(latencies.end(),
+                       measurement.latencies.begin(),
+                       measurement.latencies.end());
+      transportErrors += measurement.transportErrors;
+      bodyBytes += measurement.bodyBytes;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    QJsonObject latency;
+    latency["p50"] = percentile(latencies, 0.5);
+    latency["p90"] = percentile(latencies, 0.9);
+    latency["p99"] = percentile(latencies, 0.99);
+    latency["p999"] = percentile(latencies, 0.999);
+
+    QJsonObject result;
+    result["route"] = route.name;
+    result["state"] = stateName;
+    result["requests"] = static_cast<qint64>(latencies.size());
+    result["transportErrors"] = static_cast<qint64>(transportErrors);
+    result["requestsPerSecond"] = latencies.size() / wallSeconds;
+    result["bodyBytesPerResponse"] =
+        latencies.empty() ? 0.0
+                          : static_cast<double>(bodyBytes) / latencies.size();
+    result["latencyUs"] = latency;
+
+    // Server side view of the same run, to cross check client numbers
+    if (const auto* served = apiServer.metrics().find(route.servedRoute)) {
+      QJsonObject server;
+      server["requests"] = static_cast<qint64>(served->requests());
+      server["meanLatencyUs"] =
+          0 == served->requests()
+              ? 0.0
+              : static_cast<double>(served->latency().count()) /
+                    served->requests();
+      result["server"] = server;
+    }
+    return result;
+  }
+} // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Closed loop throughput benchmark of API Mock routes");
+  parser.addHelpOption();
+  QCommandLineOption clientsOption(
+      "clients", "Number of concurrent clients.", "count", "4");
+  QCommandLineOption workersOption(
+      "workers",
+      "Number of API Mock worker threads, 0 serves on main thread.",
+      "count",
+      "0");
+  QCommandLineOption durationOption(
+      "duration", "Duration of each route and state run.", "ms", "1000");
+  QCommandLineOption noCompressionOption(
+      "no-compression", "Don't accept compressed responses.");
+  QCommandLineOption stateOption(
+      "state", "Run only given states, may be repeated.", "name");
+  QCommandLineOption outputOption(
+      "output", "Write JSON results to file instead of stdout.", "path");
+  parser.addOptions({ clientsOption,
+                      workersOption,
+                      durationOption,
+                      noCompressionOption,
+                      stateOption,
+                      outputOption });
+  parser.process(application);
+
+  auto clients = std::max(1u, parser.value(clientsOption).toUInt());
+  auto workers = parser.value(workersOption).toUInt();
+  auto duration =
+      std::chrono::milliseconds(parser.value(durationOption).toUInt());
+  auto compression = not parser.isSet(noCompressionOption);
+  auto selectedStates = parser.values(stateOption);
+
+  QJsonArray results;
+  for (const auto& route : routes()) {
+    for (const auto& [state, stateName] : states) {
+      if (not selectedStates.isEmpty() and
+          not selectedStates.contains(stateName)) {
+        continue;
+      }
+      results.append(measure(
+          route, state, stateName, clients, workers, compression, duration));
+    }
+  }
+
+  QJsonObject report;
+  report["clients"] = static_cast<qint64>(clients);
+  report["workers"] = static_cast<qint64>(workers);
+  report["durationMs"] = static_cast<qint64>(duration.count());
+  report["compression"] = compression;
+  report["results"] = results;
+  auto json = QJsonDocument(report).toJson();
+
+  if (parser.isSet(outputOption)) {
+    QFile output(parser.value(outputOption));
+    if (not output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qCritical() << "Failed to open" << output.fileName();
+      return 1;
+    }
+    output.write(json);
+  } else {
+    QFile output;
+    if (not output.open(stdout, QIODevice::WriteOnly)) {
+      return 1;
+    }
+    output.write(json);
+  }
+
+  return 0;
+}
@@ -0,0 +1,143 @@
+#include <CableTypeStore.h>
+#include <DefaultCableType.h>
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QThread>
+#include <Seeding.h>
+#include <Snapshot.h>
+#include <algorithm>
+
+/*
+ * Measures how long API Mock takes to get its store ready
+ * from dataset of given size, with growing number of threads,
+ * and from snapshot of the same dataset.
+ * Results are printed as JSON.
+ */
+
+namespace {
+  bool writeDataset(const QString& path, std::size_t records) {
+    QFile file(path);
+    if (not file.open(QIODevice::WriteOnly)) {
+      return false;
+    }
+    auto cableType =
+        QJsonDocument::fromJson(test::api::defaultCableTypeData).object();
+    for (std::size_t i = 0; i < records; ++i) {
+      cableType["id"] = QString::number(i, 16).rightJustified(
+          test::api::CableTypeStore::idLength, '0');
+      cableType["identifier"] = QString("%1-al-1c-trxple").arg(i);
+      cableType["catid"] = static_cast<int>(i);
+      cableType["customer"] = QJsonObject{
+        { "id", "5f3bc9e2502422053e08f9f1" },
+        { "code", QString("customer-%1").arg(i % 100) }
+      };
+      file.write(QJsonDocument(cableType).toJson(QJsonDocument::Compact));
+      file.write("\n");
+    }
+    return true;
+  }
+
+  QJsonObject measureSeeding(const QString& path, std::size_t threads) {
+    test::api::CableTypeStore store;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    auto seeded = test::api::seedFromNdjson(store, path, threads);
+    auto seconds = elapsed.nsecsElapsed() / 1e9;
+
+    QJsonObject result;
+    result["method"] = "ndjson";
+    result["threads"] = static_cast<qint64>(threads);
+    result["records"] = static_cast<qint64>(seeded.stored);
+    result["seconds"] = seconds;
+    result["recordsPerSecond"] = seeded.stored / seconds;
+    return result;
+  }
+
+  QJsonObject measureSnapshot(const QString& path) {
+    test::api::CableTypeStore store;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    auto loaded = test::api::loadSnapshot(store, path);
+    auto seconds = elapsed.nsecsElapsed() / 1e9;
+
+    QJsonObject result;
+    result["method"] = "snapshot";
+    result["records"] = static_cast<qint64>(loaded);
+    result["seconds"] = seconds;
+    result["recordsPerSecond"] = loaded / seconds;
+    return result;
+  }
+} // namespace
+
+int main(int argc, char* argv[]) {
+  QCoreApplication application(argc, argv);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription(
+      "Startup time of API Mock store by dataset size and thread count");
+  parser.addHelpOption();
+  QCommandLineOption recordsOption(
+      "records", "Number of cable types in dataset.", "count", "100000");
+  QCommandLineOption datasetOption(
+      "dataset",
+      "Newline delimited JSON dataset to use instead of generated one.",
+      "path");
+  QCommandLineOption outputOption(
+      "output", "Write JSON results to file instead of stdout.", "path");
+  parser.addOptions({ recordsOption, datasetOption, outputOption });
+  parser.process(application);
+
+  QTemporaryDir directory;
+  auto dataset = parser.value(datasetOption);
+  if (dataset.isEmpty()) {
+    dataset = directory.filePath("dataset.ndjson");
+    if (not writeDataset(dataset, parser.value(recordsOption).toULongLong())) {
+      qCritical() << "Failed to write" << dataset;
+      return 1;
+    }
+  }
+
+  // Thread counts double up to number of cores
+  QJsonArray results;
+  auto cores = static_cast<std::size_t>(
+      std::max(1, QThread::idealThreadCount()));
+  for (std::size_t threads = 1;; threads = std::min(threads * 2, cores)) {
+    results.append(measureSeeding(dataset, threads));
+    if (cores == threads) {
+      break;
+    }
+  }
+
+  auto snapshot = directory.filePath("dataset.snapshot");
+  {
+    test::api::CableTypeStore store;
+    test::api::seedFromNdjson(store, dataset);
+    test::api::saveSnapshot(store, snapshot);
+  }
+  results.append(measureSnapshot(snapshot));
+
+  QJsonObject report;
+  report["dataset"] = dataset;
+  report["results"] = results;
+  auto json = QJsonDocument(report).toJson();
+
+  QFile output;
+  if (parser.isSet(outputOption)) {
+    output.setFileName(parser.value(outputOption));
+    if (not output.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      qCritical() << "Failed to open" << output.fileName();
+      return 1;
+    }
+  } else if (not output.open(stdout, QIODevice::WriteOnly)) {
+    return 1;
+  }
+  output.write(json);
+
+  return 0;
+}
@@ -0,0 +1,156 @@
+#include "AccessLog.h"
+
+#include "Responses.h"
+
+#include <QDateTime>
+#include <QTimeZone>
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+  /*
+   * Records written to file at once at most.
+   */
+  static constexpr std::size_t maxBatchSize = 4096;
+
+  /*
+   * Pause of drain thread after it found ring buffer empty.
+   */
+  static constexpr std::chrono::milliseconds drainInterval{ 10 };
+
+  std::size_t slotCountOf(std::size_t capacity) {
+    return std::bit_ceil(std::max<std::size_t>(capacity, 2));
+  }
+
+  static constexpr const char* roleNames[] = {
+    "anonymous", "unknown", "user", "admin", "superuser"
+  };
+
+  void append(QByteArray& batch, const test::api::AccessLog::Record& record) {
+    auto route = record.route->toUtf8();
+    auto separator = route.indexOf(' ');
+    auto sentAt = std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.sentAt.time_since_epoch());
+
+    batch += "{\"time\":\"" +
+             QDateTime::fromMSecsSinceEpoch(sentAt.count(), QTimeZone::utc())
+                 .toString(Qt::ISODateWithMs)
+                 .toLatin1() +
+             "\",\"method\":\"" + route.left(separator) +
+             "\",\"route\":\"" + route.mid(separator + 1) +
+             "\",\"role\":\"" + roleNames[static_cast<quint8>(record.role)] +
+             "\",\"state\":\"" + test::api::nameOf(record.state) +
+             "\",\"status\":" + QByteArray::number(record.statusCode) +
+             ",\"bytesIn\":" + QByteArray::number(record.bytesIn) +
+             ",\"bytesOut\":" + QByteArray::number(record.bytesOut) +
+             ",\"serverTimeUs\":" +
+             QByteArray::number(record.serverTime.count()) + "}\n";
+  }
+} // namespace
+
+namespace test::api {
+  AccessLog::AccessLog(const QString& path, std::size_t capacity)
+    : m_slots(std::make_unique<Slot[]>(slotCountOf(capacity)))
+    , m_mask(slotCountOf(capacity) - 1)
+    , m_file(path) {
+    if (not m_file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+      throw std::runtime_error(
+          QString("Failed to open access log %1").arg(path).toStdString());
+    }
+    for (std::size_t position = 0; position <= m_mask; ++position) {
+      m_slots[position].sequence.store(position, std::memory_order_relaxed);
+    }
+    m_drainThread = std::thread([this] { drain(); });
+  }
+
+  AccessLog::~AccessLog() {
+    m_stopping.store(true, std::memory_order_release);
+    m_drainThread.join();
+  }
+
+  bool AccessLog::write(const Record& record) noexcept {
+    auto position = m_writePosition.load(std::memory_order_relaxed);
+    while (true) {
+      auto& slot = m_slots[position & m_mask];
+      auto sequence = slot.sequence.load(std::memory_order_acquire);
+      if (sequence == position) {
+        // Slot is free, claim it unless other thread was faster
+        if (m_writePosition.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed)) {
+          slot.record = record;
+          slot.sequence.store(position + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (sequence < position) {
+        // Slot still holds record not drained yet, buffer is full
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        position = m_writePosition.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  quint64 AccessLog::written() const noexcept {
+    return m_written.load(std::memory_order_relaxed);
+  }
+
+  quint64 AccessLog::dropped() const noexcept {
+    return m_dropped.load(std::memory_order_relaxed);
+  }
+
+  QByteArray AccessLog::exposition() const {
+    return "# HELP api_mock_access_log_records_total "
+           "Access log records written to file.\n"
+           "# TYPE api_mock_access_log_records_total counter\n"
+           "api_mock_access_log_records_total " +
+           QByteArray::number(written()) +
+           "\n"
+           "# HELP api_mock_access_log_dropped_total "
+           "Access log records dropped because buffer was full.\n"
+           "# TYPE api_mock_access_log_dropped_total counter\n"
+           "api_mock_access_log_dropped_total " +
+           QByteArray::number(dropped()) + '\n';
+  }
+
+  bool AccessLog::read(Record& record) noexcept {
+    auto& slot = m_slots[m_readPosition & m_mask];
+    if (slot.sequence.load(std::memory_order_acquire) != m_readPosition + 1) {
+      return false;
+    }
+    record = slot.record;
+    // Slot becomes free for position one lap ahead
+    slot.sequence.store(m_readPosition + m_mask + 1, std::memory_order_release);
+    ++m_readPosition;
+    return true;
+  }
+
+  void AccessLog::drain() {
+    QByteArray batch;
+    Record record;
+    while (true) {
+      // Records put before stop was requested are drained in this pass
+      auto stopping = m_stopping.load(std::memory_order_acquire);
+      std::size_t drained = 0;
+      while (drained < maxBatchSize and read(record)) {
+        append(batch, record);
+        ++drained;
+      }
+      if (0 != drained) {
+        m_file.write(batch);
+        m_file.flush();
+        batch.clear();
+        m_written.fetch_add(drained, std::memory_order_relaxed);
+      }
+
+      if (maxBatchSize == drained) {
+        continue;
+      }
+      if (stopping) {
+        break;
+      }
+      std::this_thread::sleep_for(drainInterval);
+    }
+  }
+} // namespace test::api
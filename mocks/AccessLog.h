@@ -0,0 +1,91 @@
+#pragma once
+#include "Authorization.h"
+#include "MockApiServer.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+namespace test::api {
+  /*
+   * Access log written as newline delimited JSON, one record per request.
+   * Serving threads put records into bounded lock free ring buffer,
+   * background thread drains it to file in batches.
+   * Records which don't fit into full buffer are dropped and counted,
+   * serving threads never wait for file.
+   */
+  class AccessLog {
+
+  public:
+    using State = MockApiServer::State;
+
+    struct Record {
+      /*
+       * Route as registered, e.g. "GET /cable/type/id/<arg>",
+       * must outlive access log.
+       */
+      const QString* route = nullptr;
+      Role role = Role::Anonymous;
+      State state = State::Normal;
+      int statusCode = 0;
+      qint64 bytesIn = 0;
+      qint64 bytesOut = 0;
+      std::chrono::system_clock::time_point sentAt;
+      std::chrono::microseconds serverTime{ 0 };
+    };
+
+    /*
+     * Appends to file at path, throws std::runtime_error if it can't be
+     * opened. Capacity is rounded up to power of 2.
+     */
+    AccessLog(const QString& path, std::size_t capacity);
+
+    /*
+     * Writes records put so far before returning.
+     */
+    ~AccessLog();
+
+    AccessLog(const AccessLog&) = delete;
+    AccessLog& operator=(const AccessLog&) = delete;
+
+    /*
+     * Safe to call from multiple threads, gives false if record was dropped.
+     */
+    bool write(const Record& record) noexcept;
+
+    quint64 written() const noexcept;
+    quint64 dropped() const noexcept;
+
+    /*
+     * Counters of access log in Prometheus text exposition format.
+     */
+    QByteArray exposition() const;
+
+  private:
+    struct Slot {
+      /*
+       * Equals position of slot when free to write,
+       * position + 1 once record is written.
+       */
+      std::atomic<std::size_t> sequence;
+      Record record;
+    };
+
+    bool read(Record& record) noexcept;
+    void drain();
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+    alignas(64) std::atomic<std::size_t> m_writePosition = 0;
+    alignas(64) std::size_t m_readPosition = 0;
+    alignas(64) std::atomic<quint64> m_dropped = 0;
+    std::atomic<quint64> m_written = 0;
+    std::atomic<bool> m_stopping = false;
+    QFile m_file;
+    std::thread m_drainThread;
+  };
+} // namespace test::api
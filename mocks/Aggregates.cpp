@@ -0,0 +1,103 @@
+#include "Aggregates.h"
+
+#include <cmath>
+
+namespace {
+  /*
+   * Value of field which is aggregated, missing values and NaN are not.
+   */
+  std::optional<double> aggregatedValueOf(const test::api::CableType& cableType,
+                                          test::api::NumericField field) {
+    const auto& measure = cableType.measure(field);
+    if (not measure or std::isnan(measure->value)) {
+      return std::nullopt;
+    }
+    return measure->value;
+  }
+} // namespace
+
+namespace test::api {
+  void CableTypeAggregates::add(const CableType& cableType) {
+    add(m_byCustomer, cableType.customerCode, cableType);
+    add(m_byManufacturer, cableType.manufacturerId, cableType);
+  }
+
+  void CableTypeAggregates::remove(const CableType& cableType) {
+    remove(m_byCustomer, cableType.customerCode, cableType);
+    remove(m_byManufacturer, cableType.manufacturerId, cableType);
+  }
+
+  Statistics CableTypeAggregates::summary() const {
+    return { summaryOf(m_byCustomer), summaryOf(m_byManufacturer) };
+  }
+
+  void CableTypeAggregates::add(Groups& groups,
+                                const QString& key,
+                                const CableType& cableType) {
+    auto& group = groups[key];
+    ++group.cableTypes;
+    for (std::size_t i = 0; i < aggregatedFields.size(); ++i) {
+      auto value = aggregatedValueOf(cableType, aggregatedFields[i]);
+      if (not value) {
+        continue;
+      }
+      auto& field = group.fields[i];
+      ++field.count;
+      field.sum += *value;
+      ++field.values[*value];
+    }
+  }
+
+  void CableTypeAggregates::remove(Groups& groups,
+                                   const QString& key,
+                                   const CableType& cableType) {
+    auto group = groups.find(key);
+    if (group == groups.end()) {
+      return;
+    }
+    if (0 == --group->second.cableTypes) {
+      // Dropping whole group also drops rounding error of its sums
+      groups.erase(group);
+      return;
+    }
+    for (std::size_t i = 0; i < aggregatedFields.size(); ++i) {
+      auto value = aggregatedValueOf(cableType, aggregatedFields[i]);
+      if (not value) {
+        continue;
+      }
+      auto& field = group->second.fields[i];
+      auto stored = field.values.find(*value);
+      if (stored == field.values.end()) {
+        continue;
+      }
+      if (0 == --stored->second) {
+        field.values.erase(stored);
+      }
+      --field.count;
+      field.sum = 0 == field.count ? 0.0 : field.sum - *value;
+    }
+  }
+
+  std::vector<GroupSummary>
+  CableTypeAggregates::summaryOf(const Groups& groups) {
+    std::vector<GroupSummary> summaries;
+    summaries.reserve(groups.size());
+    for (const auto& [key, group] : groups) {
+      auto& summary = summaries.emplace_back();
+      summary.key = key;
+      summary.cableTypes = group.cableTypes;
+      for (std::size_t i = 0; i < aggregatedFields.size(); ++i) {
+        const auto& field = group.fields[i];
+        auto& fieldSummary = summary.fields[i];
+        fieldSummary.count = field.count;
+        fieldSummary.sum = field.sum;
+        if (not field.values.empty()) {
+          fieldSummary.min = field.values.begin()->first;
+          fieldSummary.max = field.values.rbegin()->first;
+          fieldSummary.mean = field.sum / static_cast<double>(field.count);
+        }
+      }
+    }
+    return summaries;
+  }
+} // namespace test::api
@@ -0,0 +1,86 @@
+#pragma once
+#include "CableType.h"
+
+#include <QString>
+#include <array>
+#include <map>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Numeric fields statistics are kept for.
+   */
+  inline constexpr std::array aggregatedFields = { NumericField::CurrentPrice,
+                                                   NumericField::Voltage,
+                                                   NumericField::NetWeight };
+
+  struct FieldSummary {
+    /*
+     * Cable types having the field, min, max and mean are NaN if none.
+     */
+    quint64 count = 0;
+    double sum = 0.0;
+    double min = std::numeric_limits<double>::quiet_NaN();
+    double max = std::numeric_limits<double>::quiet_NaN();
+    double mean = std::numeric_limits<double>::quiet_NaN();
+  };
+
+  struct GroupSummary {
+    QString key;
+    quint64 cableTypes = 0;
+    std::array<FieldSummary, aggregatedFields.size()> fields;
+  };
+
+  struct Statistics {
+    std::vector<GroupSummary> customers;
+    std::vector<GroupSummary> manufacturers;
+  };
+
+  /*
+   * Count, sum, min and max of aggregated fields per customer code
+   * and per manufacturer id, updated on every write to store.
+   * Values of each group are kept ordered, so removing current min or max
+   * doesn't need a scan, summary costs number of groups only.
+   * Not thread safe, CableTypeStore guards it.
+   */
+  class CableTypeAggregates {
+
+  public:
+    CableTypeAggregates() = default;
+    ~CableTypeAggregates() = default;
+
+    void add(const CableType& cableType);
+
+    /*
+     * Cable type must have been added before.
+     */
+    void remove(const CableType& cableType);
+
+    Statistics summary() const;
+
+  private:
+    struct FieldAggregate {
+      quint64 count = 0;
+      double sum = 0.0;
+      std::map<double, quint64> values;
+    };
+
+    struct Group {
+      quint64 cableTypes = 0;
+      std::array<FieldAggregate, aggregatedFields.size()> fields;
+    };
+
+    using Groups = std::map<QString, Group>;
+
+    static void add(Groups& groups,
+                    const QString& key,
+                    const CableType& cableType);
+    static void remove(Groups& groups,
+                       const QString& key,
+                       const CableType& cableType);
+    static std::vector<GroupSummary> summaryOf(const Groups& groups);
+
+    Groups m_byCustomer;
+    Groups m_byManufacturer;
+  };
+} // namespace test::api
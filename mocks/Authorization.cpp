@@ -0,0 +1,58 @@
+#include "Authorization.h"
+
+#include <unordered_map>
+
+namespace {
+  /*
+   * Predefined map of user ids to their hardcoded JWT token.
+   * Enough for test purpose to imitate logged in user.
+   */
+  static const std::unordered_map<QString, QString> users = {
+    {"superuser",
+     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+     "eyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
+     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
+
+    {    "admin",
+     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+     "fyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
+     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
+
+    {     "user",
+     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
+     "gyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
+     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
+  };
+} // namespace
+
+namespace test::api {
+  const QString& tokenOf(const QString& userRole) {
+    return users.at(userRole);
+  }
+
+  Role resolveRole(const QByteArray& token) {
+    static const auto rolesByToken = [] {
+      std::unordered_map<QByteArray, Role> result;
+      result.emplace(users.at("superuser").toUtf8(), Role::Superuser);
+      result.emplace(users.at("admin").toUtf8(), Role::Admin);
+      result.emplace(users.at("user").toUtf8(), Role::User);
+      return result;
+    }();
+
+    if (token.isEmpty()) {
+      return Role::Anonymous;
+    }
+
+    auto role = rolesByToken.find(token);
+    return role == rolesByToken.end() ? Role::Unknown : role->second;
+  }
+
+  Role resolveRole(const QHttpServerRequest& request) {
+    return resolveRole(request.value("Authorization"));
+  }
+
+  bool isPermitted(const QHttpServerRequest& request,
+                   Permissions permissions) {
+    return permissions & permissionOf(resolveRole(request));
+  }
+} // namespace test::api
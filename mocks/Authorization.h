@@ -0,0 +1,40 @@
+#pragma once
+#include <QByteArray>
+#include <QHttpServerRequest>
+#include <QString>
+
+namespace test::api {
+  enum class Role : quint8 { Anonymous, Unknown, User, Admin, Superuser };
+
+  using Permissions = quint8;
+
+  constexpr Permissions permissionOf(Role role) noexcept {
+    return static_cast<Permissions>(1u << static_cast<quint8>(role));
+  }
+
+  template <typename... Roles>
+  constexpr Permissions permit(Roles... roles) noexcept {
+    return (permissionOf(roles) | ...);
+  }
+
+  inline constexpr Permissions superuserOnly = permit(Role::Superuser);
+  inline constexpr Permissions adminsOnly =
+      permit(Role::Admin, Role::Superuser);
+
+  /*
+   * API Mock doesn't validate tokens for read access,
+   * any token provided is enough.
+   */
+  inline constexpr Permissions anyToken =
+      permit(Role::Unknown, Role::User, Role::Admin, Role::Superuser);
+
+  /*
+   * Hardcoded JWT token of user role.
+   * Throws std::out_of_range for unknown role.
+   */
+  const QString& tokenOf(const QString& userRole);
+
+  Role resolveRole(const QByteArray& token);
+  Role resolveRole(const QHttpServerRequest& request);
+  bool isPermitted(const QHttpServerRequest& request, Permissions permissions);
+} // namespace test::api
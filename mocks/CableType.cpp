@@ -0,0 +1,179 @@
+#include "CableType.h"
+
+#include <QJsonArray>
+#include <QStringList>
+#include <cmath>
+
+namespace {
+  using test::api::NumericField;
+
+  /*
+   * Order must follow NumericField enumeration.
+   */
+  static constexpr const char* numericFieldPaths[] = {
+    "diameter.published",  "diameter.actual",
+    "conductor.size",      "insulation.thickness",
+    "material.weight.net", "material.weight.calculated",
+    "currentPrice",        "voltage",
+    "rotationFrequency"
+  };
+  static_assert(std::size(numericFieldPaths) == test::api::numericFieldCount);
+
+  QJsonValue valueAt(const QJsonObject& document, const QString& path) {
+    QJsonValue value = document;
+    for (const auto& key : path.split('.')) {
+      value = value.toObject().value(key);
+    }
+    return value;
+  }
+
+  void insertAt(QJsonObject& object,
+                QStringList::const_iterator key,
+                QStringList::const_iterator end,
+                const QJsonValue& value) {
+    if (std::next(key) == end) {
+      object.insert(*key, value);
+      return;
+    }
+    auto child = object.value(*key).toObject();
+    insertAt(child, std::next(key), end, value);
+    object.insert(*key, child);
+  }
+
+  void insertAt(QJsonObject& document,
+                const QString& path,
+                const QJsonValue& value) {
+    auto keys = path.split('.');
+    insertAt(document, keys.cbegin(), keys.cend(), value);
+  }
+
+  void insertString(QJsonObject& document,
+                    const QString& path,
+                    const QString& string) {
+    if (not string.isEmpty()) {
+      insertAt(document, path, string);
+    }
+  }
+
+  std::optional<double> optionalDouble(const QJsonValue& value) {
+    if (not value.isDouble()) {
+      return std::nullopt;
+    }
+    return value.toDouble();
+  }
+} // namespace
+
+namespace test::api {
+  QString pathOf(NumericField field) {
+    return numericFieldPaths[static_cast<std::size_t>(field)];
+  }
+
+  std::optional<NumericField> numericFieldOf(const QString& path) {
+    for (auto field : numericFields) {
+      if (pathOf(field) == path) {
+        return field;
+      }
+    }
+    return std::nullopt;
+  }
+
+  CableType CableType::fromJson(const QJsonObject& document) {
+    CableType cableType;
+    cableType.id = document["id"].toString();
+    cableType.identifier = document["identifier"].toString();
+    cableType.catid = document["catid"].toInt();
+
+    for (auto field : numericFields) {
+      auto measure = valueAt(document, pathOf(field));
+      if (measure.isObject()) {
+        auto value = measure["value"];
+        cableType.measure(field) = Measure{
+          value.isDouble() ? value.toDouble()
+                           : std::numeric_limits<double>::quiet_NaN(),
+          measure["unit"].toString()
+        };
+      }
+    }
+
+    auto conductorNumber = document["conductor"]["number"];
+    if (conductorNumber.isDouble()) {
+      cableType.conductorNumber = conductorNumber.toInt();
+    }
+    cableType.insulationType = document["insulation"]["type"].toString();
+    cableType.insulationShield = document["insulation"]["shield"].toString();
+    cableType.insulationJacket = document["insulation"]["jacket"].toString();
+    cableType.aluminum = optionalDouble(document["material"]["aluminum"]);
+    cableType.copper = optionalDouble(document["material"]["copper"]);
+    cableType.manufacturerId = document["manufacturer"]["id"].toString();
+    cableType.manufacturerName = document["manufacturer"]["name"].toString();
+    for (QJsonValue property : document["properties"].toArray()) {
+      cableType.properties.push_back(
+          { property["name"].toString(), property["value"] });
+    }
+    cableType.customerId = document["customer"]["id"].toString();
+    cableType.customerCode = document["customer"]["code"].toString();
+    cableType.metadata = document["metadata"].toObject();
+    return cableType;
+  }
+
+  QJsonObject CableType::toJson() const {
+    QJsonObject document;
+    insertString(document, "id", id);
+    insertString(document, "identifier", identifier);
+    document["catid"] = catid;
+
+    for (auto field : numericFields) {
+      const auto& fieldMeasure = measure(field);
+      if (not fieldMeasure) {
+        continue;
+      }
+      QJsonObject measureObject;
+      if (not std::isnan(fieldMeasure->value)) {
+        measureObject["value"] = fieldMeasure->value;
+      }
+      if (not fieldMeasure->unit.isEmpty()) {
+        measureObject["unit"] = fieldMeasure->unit;
+      }
+      insertAt(document, pathOf(field), measureObject);
+    }
+
+    if (conductorNumber) {
+      insertAt(document, "conductor.number", *conductorNumber);
+    }
+    insertString(document, "insulation.type", insulationType);
+    insertString(document, "insulation.shield", insulationShield);
+    insertString(document, "insulation.jacket", insulationJacket);
+    if (aluminum) {
+      insertAt(document, "material.aluminum", *aluminum);
+    }
+    if (copper) {
+      insertAt(document, "material.copper", *copper);
+    }
+    insertString(document, "manufacturer.id", manufacturerId);
+    insertString(document, "manufacturer.name", manufacturerName);
+    if (not properties.empty()) {
+      QJsonArray propertyArray;
+      for (const auto& property : properties) {
+        propertyArray.append(
+            QJsonObject{ { "name", property.name },
+                         { "value", property.value } });
+      }
+      document["properties"] = propertyArray;
+    }
+    insertString(document, "customer.id", customerId);
+    insertString(document, "customer.code", customerCode);
+    if (not metadata.isEmpty()) {
+      document["metadata"] = metadata;
+    }
+    return document;
+  }
+
+  std::optional<Measure>& CableType::measure(NumericField field) noexcept {
+    return measures[static_cast<std::size_t>(field)];
+  }
+
+  const std::optional<Measure>&
+  CableType::measure(NumericField field) const noexcept {
+    return measures[static_cast<std::size_t>(field)];
+  }
+} // namespace test::api
@@ -0,0 +1,87 @@
+#pragma once
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QString>
+#include <array>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Numeric fields of cable type schema, each is value with unit.
+   */
+  enum class NumericField : quint8 {
+    PublishedDiameter,
+    ActualDiameter,
+    ConductorSize,
+    InsulationThickness,
+    NetWeight,
+    CalculatedWeight,
+    CurrentPrice,
+    Voltage,
+    RotationFrequency
+  };
+
+  inline constexpr std::size_t numericFieldCount = 9;
+
+  inline constexpr std::array numericFields = {
+    NumericField::PublishedDiameter,   NumericField::ActualDiameter,
+    NumericField::ConductorSize,       NumericField::InsulationThickness,
+    NumericField::NetWeight,           NumericField::CalculatedWeight,
+    NumericField::CurrentPrice,        NumericField::Voltage,
+    NumericField::RotationFrequency
+  };
+  static_assert(numericFields.size() == numericFieldCount);
+
+  /*
+   * Path of numeric field in cable type document,
+   * e.g. "material.weight.net".
+   */
+  QString pathOf(NumericField field);
+  std::optional<NumericField> numericFieldOf(const QString& path);
+
+  struct Measure {
+    /*
+     * NaN if document has unit only.
+     */
+    double value = std::numeric_limits<double>::quiet_NaN();
+    QString unit;
+  };
+
+  struct Property {
+    QString name;
+    QJsonValue value;
+  };
+
+  /*
+   * Typed cable type, converted from and to JSON at HTTP boundary only.
+   * Keys missing in document (or empty strings) stay empty
+   * and are left out of JSON made of it,
+   * keys outside of schema are not kept.
+   */
+  struct CableType {
+    QString id;
+    QString identifier;
+    int catid = 0;
+    std::array<std::optional<Measure>, numericFieldCount> measures;
+    std::optional<int> conductorNumber;
+    QString insulationType;
+    QString insulationShield;
+    QString insulationJacket;
+    std::optional<double> aluminum;
+    std::optional<double> copper;
+    QString manufacturerId;
+    QString manufacturerName;
+    std::vector<Property> properties;
+    QString customerId;
+    QString customerCode;
+    QJsonObject metadata;
+
+    static CableType fromJson(const QJsonObject& document);
+    QJsonObject toJson() const;
+
+    std::optional<Measure>& measure(NumericField field) noexcept;
+    const std::optional<Measure>& measure(NumericField field) const noexcept;
+  };
+} // namespace test::api
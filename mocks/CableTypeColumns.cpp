@@ -0,0 +1,182 @@
+#include "CableTypeColumns.h"
+
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace {
+  template <typename Column>
+  void moveLastTo(Column& column, std::size_t row) {
+    if (row + 1 != column.size()) {
+      column[row] = std::move(column.back());
+    }
+    column.pop_back();
+  }
+} // namespace
+
+namespace test::api {
+  std::size_t CableTypeColumns::size() const noexcept {
+    return m_ids.size();
+  }
+
+  void CableTypeColumns::reserve(std::size_t size) {
+    m_ids.reserve(size);
+    m_identifiers.reserve(size);
+    m_catids.reserve(size);
+    for (std::size_t field = 0; field < numericFieldCount; ++field) {
+      m_values[field].reserve(size);
+      m_units[field].reserve(size);
+    }
+    m_manufacturerIds.reserve(size);
+    m_manufacturerNames.reserve(size);
+    m_customerCodes.reserve(size);
+    m_propertyNames.reserve(size);
+  }
+
+  CableTypeColumns::Row CableTypeColumns::append(const CableType& cableType) {
+    auto row = size();
+    m_ids.emplace_back();
+    m_identifiers.emplace_back();
+    m_catids.emplace_back();
+    for (std::size_t field = 0; field < numericFieldCount; ++field) {
+      m_values[field].emplace_back();
+      m_units[field].emplace_back();
+    }
+    m_manufacturerIds.emplace_back();
+    m_manufacturerNames.emplace_back();
+    m_customerCodes.emplace_back();
+    m_propertyNames.emplace_back();
+    set(row, cableType);
+    return row;
+  }
+
+  void CableTypeColumns::replace(Row row, const CableType& cableType) {
+    set(row, cableType);
+  }
+
+  void CableTypeColumns::remove(Row row) {
+    release(row);
+    moveLastTo(m_ids, row);
+    moveLastTo(m_identifiers, row);
+    moveLastTo(m_catids, row);
+    for (std::size_t field = 0; field < numericFieldCount; ++field) {
+      moveLastTo(m_values[field], row);
+      moveLastTo(m_units[field], row);
+    }
+    moveLastTo(m_manufacturerIds, row);
+    moveLastTo(m_manufacturerNames, row);
+    moveLastTo(m_customerCodes, row);
+    moveLastTo(m_propertyNames, row);
+  }
+
+  const QString& CableTypeColumns::id(Row row) const noexcept {
+    return m_ids[row];
+  }
+
+  const QString& CableTypeColumns::identifier(Row row) const noexcept {
+    return m_identifiers[row];
+  }
+
+  std::span<const double>
+  CableTypeColumns::values(NumericField field) const noexcept {
+    return m_values[static_cast<std::size_t>(field)];
+  }
+
+  std::span<const StringPool::Id>
+  CableTypeColumns::units(NumericField field) const noexcept {
+    return m_units[static_cast<std::size_t>(field)];
+  }
+
+  std::span<const qint32> CableTypeColumns::catids() const noexcept {
+    return m_catids;
+  }
+
+  std::span<const StringPool::Id>
+  CableTypeColumns::manufacturerIds() const noexcept {
+    return m_manufacturerIds;
+  }
+
+  std::span<const StringPool::Id>
+  CableTypeColumns::manufacturerNames() const noexcept {
+    return m_manufacturerNames;
+  }
+
+  std::span<const StringPool::Id>
+  CableTypeColumns::customerCodes() const noexcept {
+    return m_customerCodes;
+  }
+
+  std::span<const StringPool::Id>
+  CableTypeColumns::propertyNames(Row row) const noexcept {
+    return m_propertyNames[row];
+  }
+
+  const StringPool& CableTypeColumns::strings() const noexcept {
+    return m_strings;
+  }
+
+  CableType CableTypeColumns::cableType(Row row) const {
+    CableType cableType;
+    cableType.id = m_ids[row];
+    cableType.identifier = m_identifiers[row];
+    cableType.catid = m_catids[row];
+    for (auto field : numericFields) {
+      auto index = static_cast<std::size_t>(field);
+      auto value = m_values[index][row];
+      const auto& unit = m_strings.at(m_units[index][row]);
+      if (not std::isnan(value) or not unit.isEmpty()) {
+        cableType.measure(field) = Measure{ value, unit };
+      }
+    }
+    cableType.manufacturerId = m_strings.at(m_manufacturerIds[row]);
+    cableType.manufacturerName = m_strings.at(m_manufacturerNames[row]);
+    cableType.customerCode = m_strings.at(m_customerCodes[row]);
+    for (auto name : m_propertyNames[row]) {
+      cableType.properties.push_back({ m_strings.at(name), {} });
+    }
+    return cableType;
+  }
+
+  void CableTypeColumns::set(Row row, const CableType& cableType) {
+    // New strings are interned before old ones are released,
+    // so strings kept by replaced cable type stay in pool
+    auto intern = [this](StringPool::Id& id, const QString& string) {
+      m_strings.release(std::exchange(id, m_strings.intern(string)));
+    };
+
+    m_ids[row] = cableType.id;
+    m_identifiers[row] = cableType.identifier;
+    m_catids[row] = cableType.catid;
+    for (auto field : numericFields) {
+      auto index = static_cast<std::size_t>(field);
+      const auto& measure = cableType.measure(field);
+      m_values[index][row] =
+          measure ? measure->value : std::numeric_limits<double>::quiet_NaN();
+      intern(m_units[index][row], measure ? measure->unit : QString());
+    }
+    intern(m_manufacturerIds[row], cableType.manufacturerId);
+    intern(m_manufacturerNames[row], cableType.manufacturerName);
+    intern(m_customerCodes[row], cableType.customerCode);
+    std::vector<StringPool::Id> names;
+    names.reserve(cableType.properties.size());
+    for (const auto& property : cableType.properties) {
+      names.push_back(m_strings.intern(property.name));
+    }
+    std::swap(names, m_propertyNames[row]);
+    for (auto name : names) {
+      m_strings.release(name);
+    }
+  }
+
+  void CableTypeColumns::release(Row row) {
+    for (const auto& units : m_units) {
+      m_strings.release(units[row]);
+    }
+    m_strings.release(m_manufacturerIds[row]);
+    m_strings.release(m_manufacturerNames[row]);
+    m_strings.release(m_customerCodes[row]);
+    for (auto name : m_propertyNames[row]) {
+      m_strings.release(name);
+    }
+  }
+} // namespace test::api
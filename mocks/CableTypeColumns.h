@@ -0,0 +1,83 @@
+#pragma once
+#include "CableType.h"
+#include "StringPool.h"
+
+#include <QString>
+#include <array>
+#include <span>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Cable types laid out column by column, one row per cable type.
+   * Values of each numeric field are contiguous, ready to be scanned,
+   * units, manufacturers, customer codes and property names are interned
+   * and released when their row is replaced or removed.
+   * Rows are kept dense, removed row is replaced by the last one.
+   * Not thread safe, CableTypeStore guards it.
+   */
+  class CableTypeColumns {
+
+  public:
+    using Row = std::size_t;
+
+    CableTypeColumns() = default;
+    ~CableTypeColumns() = default;
+
+    std::size_t size() const noexcept;
+    void reserve(std::size_t size);
+
+    Row append(const CableType& cableType);
+    void replace(Row row, const CableType& cableType);
+
+    /*
+     * Last row is moved in place of removed one.
+     */
+    void remove(Row row);
+
+    const QString& id(Row row) const noexcept;
+    const QString& identifier(Row row) const noexcept;
+
+    /*
+     * Values of field, NaN for cable types without it.
+     */
+    std::span<const double> values(NumericField field) const noexcept;
+    std::span<const StringPool::Id> units(NumericField field) const noexcept;
+    std::span<const qint32> catids() const noexcept;
+    std::span<const StringPool::Id> manufacturerIds() const noexcept;
+    std::span<const StringPool::Id> manufacturerNames() const noexcept;
+    std::span<const StringPool::Id> customerCodes() const noexcept;
+
+    /*
+     * Names of properties of row, in order of document.
+     */
+    std::span<const StringPool::Id> propertyNames(Row row) const noexcept;
+
+    const StringPool& strings() const noexcept;
+
+    /*
+     * Cable type made of row, fields which are not columns
+     * (and values of properties) are left empty.
+     */
+    CableType cableType(Row row) const;
+
+  private:
+    void set(Row row, const CableType& cableType);
+
+    /*
+     * Releases strings of row.
+     */
+    void release(Row row);
+
+    std::vector<QString> m_ids;
+    std::vector<QString> m_identifiers;
+    std::vector<qint32> m_catids;
+    std::array<std::vector<double>, numericFieldCount> m_values;
+    std::array<std::vector<StringPool::Id>, numericFieldCount> m_units;
+    std::vector<StringPool::Id> m_manufacturerIds;
+    std::vector<StringPool::Id> m_manufacturerNames;
+    std::vector<StringPool::Id> m_customerCodes;
+    std::vector<std::vector<StringPool::Id>> m_propertyNames;
+    StringPool m_strings;
+  };
+} // namespace test::api
@@ -0,0 +1,517 @@
+#include "CableTypeStore.h"
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+
+namespace {
+  QString customerCodeOf(const QJsonObject& cableType) {
+    return cableType["customer"].toObject()["code"].toString();
+  }
+
+  template <typename Map, typename Key>
+  const QString* findFirst(const Map& idsByKey, const Key& key) {
+    auto ids = idsByKey.find(key);
+    if (ids == idsByKey.end() or ids->second.empty()) {
+      return nullptr;
+    }
+    return &ids->second.front();
+  }
+
+  template <typename Map, typename Key>
+  void eraseId(Map& idsByKey, const Key& key, const QString& id) {
+    auto ids = idsByKey.find(key);
+    if (ids == idsByKey.end()) {
+      return;
+    }
+    std::erase(ids->second, id);
+    if (ids->second.empty()) {
+      idsByKey.erase(ids);
+    }
+  }
+} // namespace
+
+namespace test::api {
+  bool CableTypeStore::insert(QJsonObject cableType) {
+    std::unique_lock lock{ m_mutex };
+    return insertLocked(std::move(cableType));
+  }
+
+  std::size_t CableTypeStore::insert(std::vector<Entry> cableTypes,
+                                     std::vector<CableType> typed) {
+    std::unique_lock lock{ m_mutex };
+    m_byId.reserve(m_byId.size() + cableTypes.size());
+    m_entries.reserve(m_entries.size() + cableTypes.size());
+
+    // Ids are checked first, so other indexes get only stored cable types
+    std::vector<CableType> stored;
+    stored.reserve(cableTypes.size());
+    auto firstDocument = static_cast<Document>(m_rowOfDocument.size());
+    for (std::size_t i = 0; i < cableTypes.size(); ++i) {
+      if (typed[i].id.isEmpty() or m_byId.contains(typed[i].id)) {
+        continue;
+      }
+      auto row = m_entries.size();
+      m_byId.emplace(typed[i].id, row);
+      m_entries.push_back(std::move(cableTypes[i]));
+      m_documentOfRow.push_back(
+          static_cast<Document>(m_rowOfDocument.size()));
+      m_rowOfDocument.push_back(row);
+      stored.push_back(std::move(typed[i]));
+    }
+
+    std::vector<std::thread> builders;
+    builders.emplace_back([this, &stored] {
+      for (const auto& cableType : stored) {
+        m_aggregates.add(cableType);
+      }
+    });
+    builders.emplace_back([this, &stored, firstDocument] {
+      for (std::size_t i = 0; i < stored.size(); ++i) {
+        addToInvertedIndexes(firstDocument + static_cast<Document>(i),
+                             stored[i]);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      m_columns.reserve(m_columns.size() + stored.size());
+      for (const auto& cableType : stored) {
+        m_columns.append(cableType);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      m_idsByIdentifier.reserve(m_idsByIdentifier.size() + stored.size());
+      for (const auto& cableType : stored) {
+        m_idsByIdentifier[cableType.identifier].push_back(cableType.id);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      for (const auto& cableType : stored) {
+        m_identifiers.add(cableType.identifier);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      m_idsByCatId.reserve(m_idsByCatId.size() + stored.size());
+      for (const auto& cableType : stored) {
+        m_idsByCatId[cableType.catid].push_back(cableType.id);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      m_idByIdentifierAndCustomerCode.reserve(
+          m_idByIdentifierAndCustomerCode.size() + stored.size());
+      for (const auto& cableType : stored) {
+        m_idByIdentifierAndCustomerCode.insert_or_assign(
+            CustomerScopedKey<QString>{ cableType.identifier,
+                                        cableType.customerCode },
+            cableType.id);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      m_idByCatIdAndCustomerCode.reserve(m_idByCatIdAndCustomerCode.size() +
+                                         stored.size());
+      for (const auto& cableType : stored) {
+        m_idByCatIdAndCustomerCode.insert_or_assign(
+            CustomerScopedKey<int>{ cableType.catid, cableType.customerCode },
+            cableType.id);
+      }
+    });
+    builders.emplace_back([this, &stored] {
+      for (const auto& cableType : stored) {
+        m_orderedIds.insert(cableType.id);
+      }
+    });
+    for (const auto& cableType : stored) {
+      m_orderedIdsByCustomerCode[cableType.customerCode].insert(cableType.id);
+    }
+    for (auto& builder : builders) {
+      builder.join();
+    }
+    return stored.size();
+  }
+
+  QString CableTypeStore::create(QJsonObject cableType) {
+    std::unique_lock lock{ m_mutex };
+    auto existing = m_idByIdentifierAndCustomerCode.find(
+        { cableType.value("identifier").toString(),
+          customerCodeOf(cableType) });
+    if (existing != m_idByIdentifierAndCustomerCode.end()) {
+      auto id = existing->second;
+      replaceLocked(id, std::move(cableType));
+      return id;
+    }
+
+    auto id = generateId();
+    cableType["id"] = id;
+    insertLocked(std::move(cableType));
+    return id;
+  }
+
+  bool CableTypeStore::replace(const QString& id, QJsonObject cableType) {
+    std::unique_lock lock{ m_mutex };
+    return replaceLocked(id, std::move(cableType));
+  }
+
+  bool CableTypeStore::remove(const QString& id) {
+    std::unique_lock lock{ m_mutex };
+    auto stored = m_byId.find(id);
+    if (stored == m_byId.end()) {
+      return false;
+    }
+
+    auto row = stored->second;
+    unindex(row);
+    unindexDocument(row);
+    m_aggregates.remove(m_columns.cableType(row));
+    m_byId.erase(stored);
+    auto last = m_entries.size() - 1;
+    if (row != last) {
+      m_byId[m_columns.id(last)] = row;
+      m_entries[row] = std::move(m_entries[last]);
+      m_documentOfRow[row] = m_documentOfRow[last];
+      m_rowOfDocument[m_documentOfRow[row]] = row;
+    }
+    m_entries.pop_back();
+    m_documentOfRow.pop_back();
+    m_columns.remove(row);
+    compactDocuments();
+    return true;
+  }
+
+  void CableTypeStore::reserve(std::size_t size) {
+    std::unique_lock lock{ m_mutex };
+    m_entries.reserve(size);
+    m_documentOfRow.reserve(size);
+    m_columns.reserve(size);
+    m_byId.reserve(size);
+    m_idsByIdentifier.reserve(size);
+    m_idsByCatId.reserve(size);
+    m_idByIdentifierAndCustomerCode.reserve(size);
+    m_idByCatIdAndCustomerCode.reserve(size);
+  }
+
+  std::size_t CableTypeStore::size() const {
+    std::shared_lock lock{ m_mutex };
+    return m_byId.size();
+  }
+
+  CableTypeStore::Entry CableTypeStore::findById(const QString& id) const {
+    std::shared_lock lock{ m_mutex };
+    auto stored = m_byId.find(id);
+    if (stored == m_byId.end()) {
+      return nullptr;
+    }
+    return m_entries[stored->second];
+  }
+
+  CableTypeStore::Entry
+  CableTypeStore::findByIdentifier(const QString& identifier) const {
+    std::shared_lock lock{ m_mutex };
+    const auto* id = findFirst(m_idsByIdentifier, identifier);
+    return nullptr == id ? nullptr : entryOf(*id);
+  }
+
+  CableTypeStore::Entry CableTypeStore::findByCatId(int catid) const {
+    std::shared_lock lock{ m_mutex };
+    const auto* id = findFirst(m_idsByCatId, catid);
+    return nullptr == id ? nullptr : entryOf(*id);
+  }
+
+  CableTypeStore::Entry CableTypeStore::findByIdentifierAndCustomerCode(
+      const QString& identifier,
+      const QString& customerCode) const {
+    std::shared_lock lock{ m_mutex };
+    auto id =
+        m_idByIdentifierAndCustomerCode.find({ identifier, customerCode });
+    if (id == m_idByIdentifierAndCustomerCode.end()) {
+      return nullptr;
+    }
+    return entryOf(id->second);
+  }
+
+  CableTypeStore::Entry CableTypeStore::findByCatIdAndCustomerCode(
+      int catid,
+      const QString& customerCode) const {
+    std::shared_lock lock{ m_mutex };
+    auto id = m_idByCatIdAndCustomerCode.find({ catid, customerCode });
+    if (id == m_idByCatIdAndCustomerCode.end()) {
+      return nullptr;
+    }
+    return entryOf(id->second);
+  }
+
+  CableTypeStore::Page CableTypeStore::list(const QString& customerCode,
+                                            const QString& afterId,
+                                            std::size_t limit) const {
+    std::shared_lock lock{ m_mutex };
+    const auto* ids = &m_orderedIds;
+    if (not customerCode.isEmpty()) {
+      auto customerIds = m_orderedIdsByCustomerCode.find(customerCode);
+      if (customerIds == m_orderedIdsByCustomerCode.end()) {
+        return {};
+      }
+      ids = &customerIds->second;
+    }
+
+    Page page;
+    page.cableTypes.reserve(std::min(limit, ids->size()));
+    auto id = afterId.isEmpty() ? ids->begin() : ids->upper_bound(afterId);
+    for (; id != ids->end() and page.cableTypes.size() < limit; ++id) {
+      page.cableTypes.push_back(entryOf(*id));
+    }
+    if (id != ids->end() and not page.cableTypes.empty()) {
+      page.nextAfterId = *std::prev(id);
+    }
+    return page;
+  }
+
+  std::vector<CableTypeStore::Entry> CableTypeStore::entries() const {
+    std::shared_lock lock{ m_mutex };
+    std::vector<Entry> cableTypes;
+    cableTypes.reserve(m_orderedIds.size());
+    for (const auto& id : m_orderedIds) {
+      cableTypes.push_back(entryOf(id));
+    }
+    return cableTypes;
+  }
+
+  CableTypeStore::Matches
+  CableTypeStore::findByManufacturerId(const QString& manufacturerId,
+                                       std::size_t limit,
+                                       bool documents) const {
+    std::shared_lock lock{ m_mutex };
+    return matchesOf(m_byManufacturerId.find(manufacturerId), limit, documents);
+  }
+
+  CableTypeStore::Matches
+  CableTypeStore::findByPropertyName(const QString& name,
+                                     std::size_t limit,
+                                     bool documents) const {
+    std::shared_lock lock{ m_mutex };
+    return matchesOf(m_byPropertyName.find(name), limit, documents);
+  }
+
+  std::size_t CableTypeStore::postingBytes() const {
+    std::shared_lock lock{ m_mutex };
+    return m_byManufacturerId.bytes() + m_byPropertyName.bytes();
+  }
+
+  std::vector<QString>
+  CableTypeStore::completeIdentifier(const QString& prefix,
+                                     std::size_t limit,
+                                     bool typos) const {
+    std::shared_lock lock{ m_mutex };
+    return m_identifiers.complete(prefix, limit, typos);
+  }
+
+  Statistics CableTypeStore::statistics() const {
+    std::shared_lock lock{ m_mutex };
+    return m_aggregates.summary();
+  }
+
+  bool CableTypeStore::insertLocked(QJsonObject cableType) {
+    auto typed = CableType::fromJson(cableType);
+    if (typed.id.isEmpty() or m_byId.contains(typed.id)) {
+      return false;
+    }
+
+    index(typed);
+    m_aggregates.add(typed);
+    auto row = m_columns.append(typed);
+    m_byId.emplace(typed.id, row);
+    m_entries.push_back(
+        std::make_shared<const StoredCableType>(std::move(cableType)));
+    indexDocument(row, typed);
+    return true;
+  }
+
+  bool CableTypeStore::replaceLocked(const QString& id,
+                                     QJsonObject cableType) {
+    auto stored = m_byId.find(id);
+    if (stored == m_byId.end()) {
+      return false;
+    }
+
+    auto row = stored->second;
+    unindex(row);
+    unindexDocument(row);
+    m_aggregates.remove(m_columns.cableType(row));
+    cableType["id"] = id;
+    auto typed = CableType::fromJson(cableType);
+    index(typed);
+    m_aggregates.add(typed);
+    m_columns.replace(row, typed);
+    indexDocument(row, typed);
+    m_entries[row] =
+        std::make_shared<const StoredCableType>(std::move(cableType));
+    compactDocuments();
+    return true;
+  }
+
+  QString CableTypeStore::generateId() {
+    QString id;
+    do {
+      id = QString::number(++m_idSequence, 16).rightJustified(idLength, '0');
+    } while (m_byId.contains(id));
+    return id;
+  }
+
+  const CableTypeStore::Entry&
+  CableTypeStore::entryOf(const QString& id) const {
+    return m_entries[m_byId.at(id)];
+  }
+
+  void CableTypeStore::index(const CableType& cableType) {
+    const auto& id = cableType.id;
+    const auto& identifier = cableType.identifier;
+    auto catid = cableType.catid;
+    const auto& customerCode = cableType.customerCode;
+
+    m_idsByIdentifier[identifier].push_back(id);
+    m_identifiers.add(identifier);
+    m_idsByCatId[catid].push_back(id);
+    m_idByIdentifierAndCustomerCode.insert_or_assign(
+        CustomerScopedKey<QString>{ identifier, customerCode }, id);
+    m_idByCatIdAndCustomerCode.insert_or_assign(
+        CustomerScopedKey<int>{ catid, customerCode }, id);
+    m_orderedIds.insert(id);
+    m_orderedIdsByCustomerCode[customerCode].insert(id);
+  }
+
+  void CableTypeStore::indexDocument(Row row, const CableType& cableType) {
+    auto document = static_cast<Document>(m_rowOfDocument.size());
+    m_rowOfDocument.push_back(row);
+    if (row == m_documentOfRow.size()) {
+      m_documentOfRow.push_back(document);
+    } else {
+      m_documentOfRow[row] = document;
+    }
+    addToInvertedIndexes(document, cableType);
+  }
+
+  void CableTypeStore::addToInvertedIndexes(Document document,
+                                            const CableType& cableType) {
+    if (not cableType.manufacturerId.isEmpty()) {
+      m_byManufacturerId.add(cableType.manufacturerId, document);
+    }
+
+    // Property of the same name may repeat, document is posted once
+    const auto& properties = cableType.properties;
+    for (auto property = properties.begin(); property != properties.end();
+         ++property) {
+      const auto& name = property->name;
+      auto repeated = std::any_of(
+          properties.begin(), property, [&name](const auto& previous) {
+            return previous.name == name;
+          });
+      if (not name.isEmpty() and not repeated) {
+        m_byPropertyName.add(name, document);
+      }
+    }
+  }
+
+  template <typename Visitor>
+  void CableTypeStore::forEachInvertedKey(Row row, Visitor&& visitor) {
+    const auto& strings = m_columns.strings();
+    const auto& manufacturerId =
+        strings.at(m_columns.manufacturerIds()[row]);
+    if (not manufacturerId.isEmpty()) {
+      visitor(m_byManufacturerId, manufacturerId);
+    }
+
+    // Property of the same name may repeat, document is posted once
+    auto names = m_columns.propertyNames(row);
+    for (auto name = names.begin(); name != names.end(); ++name) {
+      if (StringPool::empty != *name and
+          std::find(names.begin(), name, *name) == name) {
+        visitor(m_byPropertyName, strings.at(*name));
+      }
+    }
+  }
+
+  void CableTypeStore::unindexDocument(Row row) {
+    m_rowOfDocument[m_documentOfRow[row]] = noRow;
+    forEachInvertedKey(row, [](InvertedIndex& index, const QString& key) {
+      index.discard(key);
+    });
+  }
+
+  void CableTypeStore::compactDocuments() {
+    auto removed = m_rowOfDocument.size() - m_entries.size();
+    if (removed <= std::max(m_entries.size(), minRemovedDocuments)) {
+      return;
+    }
+
+    // Documents keep their order, so they are appended to posting lists
+    std::erase(m_rowOfDocument, noRow);
+    m_rowOfDocument.shrink_to_fit();
+    m_byManufacturerId = InvertedIndex{};
+    m_byPropertyName = InvertedIndex{};
+    for (std::size_t i = 0; i < m_rowOfDocument.size(); ++i) {
+      auto document = static_cast<Document>(i);
+      auto row = m_rowOfDocument[i];
+      m_documentOfRow[row] = document;
+      forEachInvertedKey(
+          row, [document](InvertedIndex& index, const QString& key) {
+            index.add(key, document);
+          });
+    }
+  }
+
+  CableTypeStore::Matches CableTypeStore::matchesOf(const PostingList* postings,
+                                                    std::size_t limit,
+                                                    bool documents) const {
+    Matches matches;
+    if (nullptr == postings) {
+      return matches;
+    }
+    matches.matched = postings->size();
+    postings->forEach([&](Document document) {
+      if (matches.ids.size() >= limit) {
+        return false;
+      }
+      auto row = m_rowOfDocument[document];
+      if (noRow == row) {
+        return true;
+      }
+      matches.ids.push_back(m_columns.id(row));
+      if (documents) {
+        matches.cableTypes.push_back(m_entries[row]);
+      }
+      return true;
+    });
+    return matches;
+  }
+
+  void CableTypeStore::unindex(Row row) {
+    const auto& id = m_columns.id(row);
+    const auto& identifier = m_columns.identifier(row);
+    auto catid = m_columns.catids()[row];
+    const auto& customerCode =
+        m_columns.strings().at(m_columns.customerCodes()[row]);
+
+    eraseId(m_idsByIdentifier, identifier, id);
+    m_identifiers.remove(identifier);
+    eraseId(m_idsByCatId, catid, id);
+
+    auto byIdentifier =
+        m_idByIdentifierAndCustomerCode.find({ identifier, customerCode });
+    if (byIdentifier != m_idByIdentifierAndCustomerCode.end() and
+        byIdentifier->second == id) {
+      m_idByIdentifierAndCustomerCode.erase(byIdentifier);
+    }
+
+    auto byCatId = m_idByCatIdAndCustomerCode.find({ catid, customerCode });
+    if (byCatId != m_idByCatIdAndCustomerCode.end() and
+        byCatId->second == id) {
+      m_idByCatIdAndCustomerCode.erase(byCatId);
+    }
+
+    m_orderedIds.erase(id);
+    auto customerIds = m_orderedIdsByCustomerCode.find(customerCode);
+    if (customerIds != m_orderedIdsByCustomerCode.end()) {
+      customerIds->second.erase(id);
+      if (customerIds->second.empty()) {
+        m_orderedIdsByCustomerCode.erase(customerIds);
+      }
+    }
+  }
+} // namespace test::api
@@ -0,0 +1,261 @@
+#pragma once
+#include "Aggregates.h"
+#include "CableType.h"
+#include "CableTypeColumns.h"
+#include "IdentifierIndex.h"
+#include "InvertedIndex.h"
+#include "StoredCableType.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <limits>
+#include <map>
+#include <memory>
+#include <set>
+#include <shared_mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace test::api {
+  /*
+   * In-memory storage of cable type documents.
+   * Every key used by API routes for lookups is indexed,
+   * so no request needs to parse or scan documents.
+   * Besides documents served as they are, typed fields of cable types
+   * are kept in columns, ready for queries scanning all of them.
+   * Safe to use from multiple threads.
+   */
+  class CableTypeStore {
+
+  public:
+    static constexpr qsizetype idLength = 24;
+
+    /*
+     * Stored cable type, stays valid after it is replaced or removed.
+     * Lookups give nullptr if nothing is found.
+     */
+    using Entry = std::shared_ptr<const StoredCableType>;
+
+    struct Page {
+      std::vector<Entry> cableTypes;
+
+      /*
+       * Id to continue listing after, empty if no cable types follow.
+       */
+      QString nextAfterId;
+    };
+
+    struct Matches {
+      /*
+       * Matching cable types up to limit, documents only if asked.
+       */
+      std::vector<QString> ids;
+      std::vector<Entry> cableTypes;
+
+      /*
+       * All matching cable types, regardless of limit.
+       */
+      std::size_t matched = 0;
+    };
+
+    CableTypeStore() = default;
+    ~CableTypeStore() = default;
+
+    /*
+     * Stores cable type which must contain "id".
+     * Returns false if id is missing or already taken.
+     */
+    bool insert(QJsonObject cableType);
+
+    /*
+     * Stores many cable types at once, e.g. when seeding API Mock,
+     * typed cable types are made by caller (in parallel)
+     * and must be in the same order as stored ones.
+     * Cable types without id or with id taken are skipped,
+     * returns number of cable types stored.
+     * Indexes and columns are independent, so each is built on its own thread.
+     */
+    std::size_t insert(std::vector<Entry> cableTypes,
+                       std::vector<CableType> typed);
+
+    /*
+     * Stores cable type without "id" and returns id assigned to it.
+     * Cable type with the same identifier and customer code is replaced,
+     * keeping its id.
+     */
+    QString create(QJsonObject cableType);
+
+    bool replace(const QString& id, QJsonObject cableType);
+    bool remove(const QString& id);
+    void reserve(std::size_t size);
+    std::size_t size() const;
+
+    Entry findById(const QString& id) const;
+    Entry findByIdentifier(const QString& identifier) const;
+    Entry findByCatId(int catid) const;
+    Entry findByIdentifierAndCustomerCode(const QString& identifier,
+                                          const QString& customerCode) const;
+    Entry findByCatIdAndCustomerCode(int catid,
+                                     const QString& customerCode) const;
+
+    /*
+     * Cable types of manufacturer or having property of name,
+     * in order they were stored (replaced cable type counts as stored anew).
+     * Read from inverted indexes, cost depends on limit, not on catalog size.
+     */
+    Matches findByManufacturerId(const QString& manufacturerId,
+                                 std::size_t limit,
+                                 bool documents) const;
+    Matches findByPropertyName(const QString& name,
+                               std::size_t limit,
+                               bool documents) const;
+
+    /*
+     * Encoded size of posting lists of inverted indexes.
+     */
+    std::size_t postingBytes() const;
+
+    /*
+     * Up to limit distinct identifiers starting with prefix,
+     * see IdentifierIndex::complete.
+     */
+    std::vector<QString> completeIdentifier(const QString& prefix,
+                                            std::size_t limit,
+                                            bool typos) const;
+
+    /*
+     * Lists up to limit cable types ordered by id, starting after afterId
+     * (from the beginning if empty). Empty customer code lists all customers.
+     * Cost depends on page size only, not on position of page.
+     */
+    Page list(const QString& customerCode,
+              const QString& afterId,
+              std::size_t limit) const;
+
+    /*
+     * Every stored cable type, ordered by id.
+     */
+    std::vector<Entry> entries() const;
+
+    /*
+     * Aggregates per customer and manufacturer, kept up to date on writes.
+     */
+    Statistics statistics() const;
+
+    /*
+     * Calls visitor with columns and stored cable types of their rows
+     * under shared lock and returns its result,
+     * visitor must not keep references to either.
+     */
+    template <typename Visitor>
+    decltype(auto) scan(Visitor&& visitor) const {
+      std::shared_lock lock{ m_mutex };
+      return std::forward<Visitor>(visitor)(
+          static_cast<const CableTypeColumns&>(m_columns),
+          std::span<const Entry>(m_entries));
+    }
+
+  private:
+    template <typename Key>
+    struct CustomerScopedKey {
+      Key key;
+      QString customerCode;
+
+      bool operator==(const CustomerScopedKey&) const = default;
+    };
+
+    struct CustomerScopedKeyHash {
+      template <typename Key>
+      std::size_t operator()(const CustomerScopedKey<Key>& key) const noexcept {
+        return qHashMulti(0, key.key, key.customerCode);
+      }
+    };
+
+    using Row = CableTypeColumns::Row;
+    using Document = PostingList::Document;
+
+    static constexpr Row noRow = std::numeric_limits<Row>::max();
+
+    /*
+     * Documents are renumbered once removed ones outnumber stored ones
+     * and this many of them.
+     */
+    static constexpr std::size_t minRemovedDocuments = 1024;
+
+    bool insertLocked(QJsonObject cableType);
+    bool replaceLocked(const QString& id, QJsonObject cableType);
+    QString generateId();
+    const Entry& entryOf(const QString& id) const;
+    void index(const CableType& cableType);
+
+    /*
+     * Keys to unindex are read from columns, so document is not parsed.
+     */
+    void unindex(Row row);
+
+    /*
+     * Numbers stored cable type of row for inverted indexes and adds it.
+     */
+    void indexDocument(Row row, const CableType& cableType);
+    void addToInvertedIndexes(Document document, const CableType& cableType);
+
+    /*
+     * Calls visitor with inverted index and its key for each key of row,
+     * keys are read from columns.
+     */
+    template <typename Visitor>
+    void forEachInvertedKey(Row row, Visitor&& visitor);
+
+    /*
+     * Document stays encoded in posting lists until compaction,
+     * so removal doesn't re-encode them.
+     */
+    void unindexDocument(Row row);
+
+    /*
+     * Renumbers stored cable types in order of their documents
+     * and rebuilds posting lists with them, if removed documents
+     * outnumber stored ones.
+     */
+    void compactDocuments();
+    Matches matchesOf(const PostingList* postings,
+                      std::size_t limit,
+                      bool documents) const;
+
+    /*
+     * Stored cable types and columns share rows,
+     * removed row is replaced by the last one in both.
+     */
+    std::vector<Entry> m_entries;
+    CableTypeColumns m_columns;
+    CableTypeAggregates m_aggregates;
+
+    /*
+     * Posting lists refer to document numbers, as rows move on removal.
+     * Each stored (or replaced) cable type gets next number,
+     * numbers of removed ones map to no row until compaction.
+     * Compaction keeps numbers below twice count of stored cable types
+     * (plus minRemovedDocuments), so they don't wrap.
+     */
+    std::vector<Document> m_documentOfRow;
+    std::vector<Row> m_rowOfDocument;
+    InvertedIndex m_byManufacturerId;
+    InvertedIndex m_byPropertyName;
+    IdentifierIndex m_identifiers;
+    std::unordered_map<QString, Row> m_byId;
+    std::unordered_map<QString, std::vector<QString>> m_idsByIdentifier;
+    std::unordered_map<int, std::vector<QString>> m_idsByCatId;
+    std::unordered_map<CustomerScopedKey<QString>,
+                       QString,
+                       CustomerScopedKeyHash>
+        m_idByIdentifierAndCustomerCode;
+    std::unordered_map<CustomerScopedKey<int>, QString, CustomerScopedKeyHash>
+        m_idByCatIdAndCustomerCode;
+    std::set<QString> m_orderedIds;
+    std::map<QString, std::set<QString>> m_orderedIdsByCustomerCode;
+    quint64 m_idSequence = 0;
+    mutable std::shared_mutex m_mutex;
+  };
+} // namespace test::api
@@ -0,0 +1,119 @@
+#include "Compression.h"
+
+#include <QList>
+#include <algorithm>
+#include <zlib.h>
+
+namespace {
+  /*
+   * Quality of coding in Accept-Encoding, e.g. 0.5 of "gzip;q=0.5".
+   */
+  double qualityOf(const QByteArray& coding) {
+    auto parameters = coding.indexOf(';');
+    if (parameters < 0) {
+      return 1.0;
+    }
+
+    auto parameter = coding.mid(parameters + 1).trimmed();
+    if (not parameter.startsWith("q=")) {
+      return 1.0;
+    }
+
+    bool valid = false;
+    auto quality = parameter.mid(2).toDouble(&valid);
+    return valid ? quality : 0.0;
+  }
+
+  QByteArray nameOfCoding(const QByteArray& coding) {
+    auto parameters = coding.indexOf(';');
+    return (parameters < 0 ? coding : coding.left(parameters)).trimmed();
+  }
+} // namespace
+
+namespace test::api {
+  ContentEncoding negotiateEncoding(QByteArrayView acceptEncoding) {
+    // Qualities of codings request lists, -1 for ones it doesn't
+    auto gzip = -1.0;
+    auto deflate = -1.0;
+    auto identity = -1.0;
+    auto wildcard = -1.0;
+    for (const auto& coding : acceptEncoding.toByteArray().split(',')) {
+      auto name = nameOfCoding(coding).toLower();
+      auto* quality = "gzip" == name       ? &gzip
+                      : "deflate" == name  ? &deflate
+                      : "identity" == name ? &identity
+                      : "*" == name        ? &wildcard
+                                           : nullptr;
+      if (nullptr != quality) {
+        *quality = qualityOf(coding);
+      }
+    }
+
+    // Wildcard stands for codings not listed, identity is used
+    // when no coding is accepted, so it is picked only if preferred
+    if (gzip < 0.0) {
+      gzip = std::max(wildcard, 0.0);
+    }
+    if (deflate < 0.0) {
+      deflate = std::max(wildcard, 0.0);
+    }
+    if (gzip <= 0.0 and deflate <= 0.0) {
+      return ContentEncoding::Identity;
+    }
+    if (gzip >= deflate) {
+      return gzip > identity ? ContentEncoding::Gzip
+                             : ContentEncoding::Identity;
+    }
+    return deflate > identity ? ContentEncoding::Deflate
+                              : ContentEncoding::Identity;
+  }
+
+  QByteArray nameOf(ContentEncoding encoding) {
+    switch (encoding) {
+
+    case ContentEncoding::Gzip:
+      return "gzip";
+
+    case ContentEncoding::Deflate:
+      return "deflate";
+
+    default:
+      break;
+    }
+
+    return "identity";
+  }
+
+  QByteArray encode(const QByteArray& data, ContentEncoding encoding) {
+    if (ContentEncoding::Identity == encoding) {
+      return data;
+    }
+
+    // zlib adds gzip wrapper instead of zlib one for window bits above 15
+    static constexpr int windowBits = 15;
+    const int wrapper = ContentEncoding::Gzip == encoding ? 16 : 0;
+
+    z_stream stream{};
+    if (Z_OK != deflateInit2(&stream,
+                             Z_DEFAULT_COMPRESSION,
+                             Z_DEFLATED,
+                             windowBits + wrapper,
+                             8,
+                             Z_DEFAULT_STRATEGY)) {
+      return {};
+    }
+
+    QByteArray encoded(deflateBound(&stream, data.size()), Qt::Uninitialized);
+    stream.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = reinterpret_cast<Bytef*>(encoded.data());
+    stream.avail_out = static_cast<uInt>(encoded.size());
+
+    auto result = deflate(&stream, Z_FINISH);
+    encoded.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    return Z_STREAM_END == result ? encoded : QByteArray();
+  }
+} // namespace test::api
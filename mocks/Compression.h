@@ -0,0 +1,25 @@
+#pragma once
+#include <QByteArray>
+#include <QByteArrayView>
+
+namespace test::api {
+  enum class ContentEncoding { Identity, Gzip, Deflate };
+
+  /*
+   * Picks encoding of response body from Accept-Encoding request header:
+   * accepted coding of the highest quality, gzip when qualities tie.
+   * Wildcard "*" stands for codings header doesn't list, identity
+   * is picked only if it is listed with higher quality than codings.
+   */
+  ContentEncoding negotiateEncoding(QByteArrayView acceptEncoding);
+
+  /*
+   * Name of encoding used in Content-Encoding response header.
+   */
+  QByteArray nameOf(ContentEncoding encoding);
+
+  /*
+   * Compresses data with encoding, returns data as is for Identity.
+   */
+  QByteArray encode(const QByteArray& data, ContentEncoding encoding);
+} // namespace test::api
@@ -0,0 +1,144 @@
+#include "IdentifierIndex.h"
+
+#include <iterator>
+#include <set>
+
+namespace {
+  using Identifiers = std::map<QString, std::size_t>;
+
+  /*
+   * Calls visitor with identifiers starting with prefix in ascending order
+   * until it returns false.
+   */
+  template <typename Visitor>
+  void forEachCompletion(const Identifiers& identifiers,
+                         const QString& prefix,
+                         Visitor&& visitor) {
+    for (auto identifier = identifiers.lower_bound(prefix);
+         identifier != identifiers.end() and
+         identifier->first.startsWith(prefix);
+         ++identifier) {
+      if (not visitor(identifier->first)) {
+        return;
+      }
+    }
+  }
+
+  /*
+   * Calls visitor with every character following prefix in identifiers,
+   * in ascending order until it returns false.
+   * Identifiers followed by the same character are skipped over
+   * by looking up the first one followed by next character.
+   */
+  template <typename Visitor>
+  void forEachNextCharacter(const Identifiers& identifiers,
+                            const QString& prefix,
+                            Visitor&& visitor) {
+    auto identifier = identifiers.lower_bound(prefix);
+    while (identifier != identifiers.end() and
+           identifier->first.startsWith(prefix)) {
+      if (identifier->first.size() == prefix.size()) {
+        ++identifier;
+        continue;
+      }
+
+      auto character = identifier->first[prefix.size()];
+      if (not visitor(character) or 0xffff == character.unicode()) {
+        return;
+      }
+      identifier = identifiers.lower_bound(
+          prefix + QChar(static_cast<char16_t>(character.unicode() + 1)));
+    }
+  }
+} // namespace
+
+namespace test::api {
+  void IdentifierIndex::add(const QString& identifier) {
+    if (identifier.isEmpty()) {
+      return;
+    }
+    ++m_identifiers[identifier];
+  }
+
+  void IdentifierIndex::remove(const QString& identifier) {
+    auto stored = m_identifiers.find(identifier);
+    if (stored == m_identifiers.end()) {
+      return;
+    }
+    if (0 == --stored->second) {
+      m_identifiers.erase(stored);
+    }
+  }
+
+  std::size_t IdentifierIndex::size() const noexcept {
+    return m_identifiers.size();
+  }
+
+  std::vector<QString> IdentifierIndex::complete(const QString& prefix,
+                                                 std::size_t limit,
+                                                 bool typos) const {
+    std::vector<QString> completions;
+    forEachCompletion(
+        m_identifiers, prefix, [&](const QString& identifier) {
+          if (completions.size() >= limit) {
+            return false;
+          }
+          completions.push_back(identifier);
+          return true;
+        });
+    if (not typos or completions.size() >= limit) {
+      return completions;
+    }
+
+    // Only the least wanted identifiers are kept, so walk of candidate
+    // stops once it reaches the greatest of them
+    std::set<QString> found;
+    auto wanted = limit - completions.size();
+    auto isWanted = [&](const QString& identifier) {
+      return found.size() < wanted or identifier < *found.rbegin();
+    };
+    auto collect = [&](const QString& candidate) {
+      if (candidate.isEmpty()) {
+        return;
+      }
+      forEachCompletion(
+          m_identifiers, candidate, [&](const QString& identifier) {
+            if (not isWanted(identifier)) {
+              return false;
+            }
+            // Ones starting with prefix are already completions
+            if (not identifier.startsWith(prefix) and
+                found.insert(identifier).second and found.size() > wanted) {
+              found.erase(std::prev(found.end()));
+            }
+            return true;
+          });
+    };
+
+    for (qsizetype i = 0; i < prefix.size(); ++i) {
+      const auto before = prefix.left(i);
+      collect(before + prefix.mid(i + 1));
+      if (i + 1 < prefix.size() and prefix[i] != prefix[i + 1]) {
+        collect(before + prefix[i + 1] + prefix[i] + prefix.mid(i + 2));
+      }
+
+      // Inserting the same character is inserting it at next position
+      forEachNextCharacter(m_identifiers, before, [&](QChar character) {
+        if (character == prefix[i]) {
+          return true;
+        }
+        auto replaced = before + character + prefix.mid(i + 1);
+        auto inserted = before + character + prefix.mid(i);
+        if (not isWanted(replaced) and not isWanted(inserted)) {
+          return false;
+        }
+        collect(replaced);
+        collect(inserted);
+        return true;
+      });
+    }
+
+    completions.insert(completions.end(), found.begin(), found.end());
+    return completions;
+  }
+} // namespace test::api
@@ -0,0 +1,51 @@
+#pragma once
+#include <QString>
+#include <map>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Distinct identifiers of stored cable types in ascending order,
+   * for completing ones operators start to type.
+   * Identifiers sharing prefix are neighbours, so completing prefix
+   * is a lookup of its first identifier followed by a walk of limit ones.
+   * Not thread safe, CableTypeStore guards it.
+   */
+  class IdentifierIndex {
+
+  public:
+    IdentifierIndex() = default;
+    ~IdentifierIndex() = default;
+
+    /*
+     * Identifier is kept while any cable type has it, empty one is not kept.
+     */
+    void add(const QString& identifier);
+    void remove(const QString& identifier);
+
+    /*
+     * Count of distinct identifiers.
+     */
+    std::size_t size() const noexcept;
+
+    /*
+     * Up to limit identifiers starting with prefix, in ascending order.
+     * With typos, identifiers starting with prefix with one character
+     * inserted, deleted, replaced or two adjacent ones swapped follow,
+     * also in ascending order. Prefix made empty by deleting its only
+     * character is not tried, as every identifier would match it.
+     * Typos are looked up only for characters identifiers have at edited
+     * position, so cost depends on prefix length and limit,
+     * not on number of identifiers.
+     */
+    std::vector<QString> complete(const QString& prefix,
+                                  std::size_t limit,
+                                  bool typos) const;
+
+  private:
+    /*
+     * Count of cable types per identifier.
+     */
+    std::map<QString, std::size_t> m_identifiers;
+  };
+} // namespace test::api
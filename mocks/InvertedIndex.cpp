@@ -0,0 +1,90 @@
+#include "InvertedIndex.h"
+
+namespace {
+  static constexpr quint8 continuationBit = 0x80;
+  static constexpr quint8 payloadBits = 0x7f;
+} // namespace
+
+namespace test::api {
+  void PostingList::append(Document document) {
+    encode(m_data, document - m_last);
+    m_last = document;
+    ++m_size;
+  }
+
+  void PostingList::discard() noexcept {
+    ++m_removed;
+  }
+
+  bool PostingList::isEmpty() const noexcept {
+    return m_size == m_removed;
+  }
+
+  std::size_t PostingList::size() const noexcept {
+    return m_size - m_removed;
+  }
+
+  std::size_t PostingList::bytes() const noexcept {
+    return m_data.size();
+  }
+
+  std::vector<PostingList::Document> PostingList::documents() const {
+    std::vector<Document> documents;
+    documents.reserve(m_size);
+    forEach([&documents](Document document) {
+      documents.push_back(document);
+      return true;
+    });
+    return documents;
+  }
+
+  void PostingList::encode(std::vector<quint8>& data, Document delta) {
+    while (delta > payloadBits) {
+      data.push_back(static_cast<quint8>(delta & payloadBits) |
+                     continuationBit);
+      delta >>= 7;
+    }
+    data.push_back(static_cast<quint8>(delta));
+  }
+
+  PostingList::Document
+  PostingList::decode(std::size_t& offset) const noexcept {
+    Document delta = 0;
+    std::size_t shift = 0;
+    quint8 byte = 0;
+    do {
+      byte = m_data[offset++];
+      delta |= static_cast<Document>(byte & payloadBits) << shift;
+      shift += 7;
+    } while (byte & continuationBit);
+    return delta;
+  }
+
+  void InvertedIndex::add(const QString& key, Document document) {
+    auto& postings = m_postings[key];
+    m_bytes -= postings.bytes();
+    postings.append(document);
+    m_bytes += postings.bytes();
+  }
+
+  void InvertedIndex::discard(const QString& key) {
+    auto postings = m_postings.find(key);
+    if (postings == m_postings.end()) {
+      return;
+    }
+    postings->second.discard();
+    if (postings->second.isEmpty()) {
+      m_bytes -= postings->second.bytes();
+      m_postings.erase(postings);
+    }
+  }
+
+  const PostingList* InvertedIndex::find(const QString& key) const {
+    auto postings = m_postings.find(key);
+    return postings == m_postings.end() ? nullptr : &postings->second;
+  }
+
+  std::size_t InvertedIndex::bytes() const noexcept {
+    return m_bytes;
+  }
+} // namespace test::api
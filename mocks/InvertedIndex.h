@@ -0,0 +1,108 @@
+#pragma once
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <unordered_map>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Ascending document numbers encoded as differences of consecutive ones,
+   * each in as few 7 bit groups as it needs (LEB128 varint),
+   * so dense list takes about a byte per document.
+   * Documents are numbered in order they are stored,
+   * so adding one is appending to the end.
+   * Removed documents stay encoded until owner rebuilds the list,
+   * so removal doesn't shift encoded ones, owner tells them apart.
+   */
+  class PostingList {
+
+  public:
+    using Document = quint32;
+
+    PostingList() = default;
+    ~PostingList() = default;
+
+    /*
+     * Document must be greater than every document in list.
+     */
+    void append(Document document);
+
+    /*
+     * Counts one of documents as removed, it is still visited by forEach().
+     */
+    void discard() noexcept;
+
+    /*
+     * Count of documents not removed.
+     */
+    bool isEmpty() const noexcept;
+    std::size_t size() const noexcept;
+
+    /*
+     * Encoded size.
+     */
+    std::size_t bytes() const noexcept;
+
+    /*
+     * Calls visitor with encoded documents, including removed ones,
+     * in ascending order until it returns false.
+     */
+    template <typename Visitor>
+    void forEach(Visitor&& visitor) const {
+      Document document = 0;
+      for (std::size_t offset = 0; offset < m_data.size();) {
+        document += decode(offset);
+        if (not visitor(document)) {
+          return;
+        }
+      }
+    }
+
+    std::vector<Document> documents() const;
+
+  private:
+    static void encode(std::vector<quint8>& data, Document delta);
+    Document decode(std::size_t& offset) const noexcept;
+
+    std::vector<quint8> m_data;
+    std::size_t m_size = 0;
+    std::size_t m_removed = 0;
+    Document m_last = 0;
+  };
+
+  /*
+   * Posting list of documents per key, e.g. manufacturer id.
+   * Not thread safe, CableTypeStore guards it.
+   */
+  class InvertedIndex {
+
+  public:
+    using Document = PostingList::Document;
+
+    InvertedIndex() = default;
+    ~InvertedIndex() = default;
+
+    void add(const QString& key, Document document);
+
+    /*
+     * Counts one of documents of key as removed (see PostingList::discard()),
+     * posting list of key is dropped once all its documents are removed.
+     */
+    void discard(const QString& key);
+
+    /*
+     * Gives nullptr for key without documents.
+     */
+    const PostingList* find(const QString& key) const;
+
+    /*
+     * Encoded size of all posting lists.
+     */
+    std::size_t bytes() const noexcept;
+
+  private:
+    std::unordered_map<QString, PostingList> m_postings;
+    std::size_t m_bytes = 0;
+  };
+} // namespace test::api
@@ -0,0 +1,84 @@
+#include "Latency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace {
+  using std::chrono::microseconds;
+
+  microseconds sampleOf(std::monostate, std::mt19937_64&) {
+    return microseconds{ 0 };
+  }
+
+  microseconds sampleOf(const test::api::latency::Constant& constant,
+                        std::mt19937_64&) {
+    return constant.delay;
+  }
+
+  microseconds sampleOf(const test::api::latency::Uniform& uniform,
+                        std::mt19937_64& random) {
+    if (uniform.max <= uniform.min) {
+      return uniform.min;
+    }
+    std::uniform_int_distribution<microseconds::rep> distribution(
+        uniform.min.count(), uniform.max.count());
+    return microseconds{ distribution(random) };
+  }
+
+  microseconds sampleOf(const test::api::latency::LogNormal& logNormal,
+                        std::mt19937_64& random) {
+    if (logNormal.median.count() <= 0) {
+      return microseconds{ 0 };
+    }
+    std::lognormal_distribution<double> distribution(
+        std::log(static_cast<double>(logNormal.median.count())),
+        logNormal.sigma);
+    return microseconds{ std::llround(distribution(random)) };
+  }
+
+  microseconds sampleOf(const test::api::latency::Histogram& histogram,
+                        std::mt19937_64& random) {
+    const auto& buckets = histogram.buckets();
+    if (buckets.empty()) {
+      return microseconds{ 0 };
+    }
+
+    auto bucket = histogram.pickBucket(random);
+    auto lowerBound =
+        0 == bucket ? microseconds{ 0 } : buckets[bucket - 1].upperBound;
+    return sampleOf(
+        test::api::latency::Uniform{ lowerBound, buckets[bucket].upperBound },
+        random);
+  }
+} // namespace
+
+namespace test::api::latency {
+  Histogram::Histogram(std::vector<Bucket> buckets)
+    : m_buckets(std::move(buckets)) {
+    std::vector<double> weights;
+    weights.reserve(m_buckets.size());
+    for (const auto& bucket : m_buckets) {
+      weights.push_back(bucket.weight);
+    }
+    m_weights = decltype(m_weights)(weights.begin(), weights.end());
+  }
+
+  const std::vector<Histogram::Bucket>& Histogram::buckets() const noexcept {
+    return m_buckets;
+  }
+
+  std::size_t Histogram::pickBucket(std::mt19937_64& random) const {
+    // Distribution keeps no state of its own, weights are passed to it
+    thread_local std::discrete_distribution<std::size_t> distribution;
+    return distribution(random, m_weights);
+  }
+
+  std::chrono::microseconds sample(const Distribution& distribution,
+                                   std::mt19937_64& random) {
+    auto delay = std::visit(
+        [&random](const auto& kind) { return sampleOf(kind, random); },
+        distribution);
+    return std::max(microseconds{ 0 }, delay);
+  }
+} // namespace test::api::latency
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <random>
+#include <variant>
+#include <vector>
+
+namespace test::api::latency {
+  struct Constant {
+    std::chrono::microseconds delay{ 0 };
+  };
+
+  struct Uniform {
+    std::chrono::microseconds min{ 0 };
+    std::chrono::microseconds max{ 0 };
+  };
+
+  /*
+   * Long tailed latency, e.g. median 5 ms with sigma 1 gives p99 about 50 ms.
+   */
+  struct LogNormal {
+    std::chrono::microseconds median{ 0 };
+    double sigma = 0.0;
+  };
+
+  /*
+   * Latency taken from measured histogram, e.g. of production traffic.
+   * Bucket is picked by its weight, latency is uniform within bucket,
+   * which spans from upper bound of previous bucket to its own.
+   * Weights are prepared once, so picking bucket doesn't allocate.
+   */
+  class Histogram {
+
+  public:
+    struct Bucket {
+      std::chrono::microseconds upperBound{ 0 };
+      double weight = 0.0;
+    };
+
+    Histogram() = default;
+    explicit Histogram(std::vector<Bucket> buckets);
+
+    const std::vector<Bucket>& buckets() const noexcept;
+
+    /*
+     * Index of bucket picked by its weight, histogram must not be empty.
+     */
+    std::size_t pickBucket(std::mt19937_64& random) const;
+
+  private:
+    std::vector<Bucket> m_buckets;
+    std::discrete_distribution<std::size_t>::param_type m_weights;
+  };
+
+  /*
+   * No latency added if distribution is not set.
+   */
+  using Distribution =
+      std::variant<std::monostate, Constant, Uniform, LogNormal, Histogram>;
+
+  std::chrono::microseconds sample(const Distribution& distribution,
+                                   std::mt19937_64& random);
+} // namespace test::api::latency
@@ -0,0 +1,369 @@
+#include "LimitingTcpServer.h"
+
+#include "Responses.h"
+
+#include <QHash>
+#include <QHostAddress>
+#include <QPointer>
+#include <QTcpSocket>
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace {
+  using Limits = test::api::LimitingTcpServer::Limits;
+
+  /*
+   * Headers, and lines of chunked body, are looked for only within
+   * this many bytes, request with longer ones is not followed further
+   * and everything after is counted as its body.
+   */
+  static constexpr qint64 maxHeadSize = 16 * 1024;
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+  /*
+   * Address of connection as both its socket and its requests know it.
+   */
+  struct Peer {
+    quint16 localPort = 0;
+    QHostAddress address;
+    quint16 port = 0;
+
+    bool operator==(const Peer&) const = default;
+  };
+
+  std::size_t qHash(const Peer& peer, std::size_t seed = 0) noexcept {
+    return qHashMulti(seed, peer.localPort, peer.address, peer.port);
+  }
+
+  /*
+   * Connections taken on thread, socket removes itself once destroyed.
+   */
+  thread_local QHash<Peer, QTcpSocket*> connections;
+#else
+  thread_local QPointer<QTcpSocket> receivingSocket;
+#endif
+
+  /*
+   * Part of request expected next on connection.
+   */
+  enum class Stage {
+    Head,
+    Body,      // Content-Length bytes
+    ChunkSize, // line with size of next chunk
+    ChunkData,
+    ChunkEnd,  // line break after chunk data
+    Trailer,   // header lines until empty one
+    Unframed   // framing is not understood, so rest is body
+  };
+
+  /*
+   * Progress of request currently arriving on connection,
+   * owned by its socket.
+   */
+  struct Intake : QObject {
+    explicit Intake(QTcpSocket& socket)
+      : QObject(&socket) { }
+
+    Stage stage = Stage::Head;
+    QByteArray line; // head or chunked body line received so far
+    qint64 remaining = 0; // bytes of body or chunk still to arrive
+    qint64 bodyReceived = 0;
+    qint64 maxBodySize = 0;
+    bool rejected = false;
+  };
+
+  /*
+   * Value of header of head, e.g. "chunked" of "Transfer-Encoding",
+   * null if head has no such header.
+   */
+  QByteArray headerOf(const QByteArray& head, const char* name) {
+    for (const auto& line : head.split('\n')) {
+      auto separator = line.indexOf(':');
+      if (separator >= 0 and
+          0 == line.left(separator).trimmed().compare(name,
+                                                      Qt::CaseInsensitive)) {
+        return line.mid(separator + 1).trimmed();
+      }
+    }
+    return {};
+  }
+
+  qint64 contentLengthOf(const QByteArray& head) {
+    auto header = headerOf(head, "Content-Length");
+    bool valid = false;
+    auto length = header.toLongLong(&valid);
+    return valid ? length : -1;
+  }
+
+  bool isChunked(const QByteArray& head) {
+    return headerOf(head, "Transfer-Encoding").toLower().contains("chunked");
+  }
+
+  /*
+   * Size of chunk of its size line, e.g. 0x1a of "1a;name=value\r\n",
+   * -1 if line is not valid.
+   */
+  qint64 chunkSizeOf(const QByteArray& line) {
+    auto end = line.indexOf(';');
+    bool valid = false;
+    auto size = line.left(end).trimmed().toLongLong(&valid, 16);
+    return valid ? size : -1;
+  }
+
+  /*
+   * Path of request line, e.g. "/cable/type" of "POST /cable/type HTTP/1.1".
+   */
+  QByteArray pathOf(const QByteArray& head) {
+    auto begin = head.indexOf(' ') + 1;
+    auto end = head.indexOf(' ', begin);
+    if (0 == begin or end < 0) {
+      return {};
+    }
+    return head.mid(begin, end - begin);
+  }
+
+  qint64 maxBodySizeOf(const QByteArray& path, const Limits& limits) {
+    for (const auto& [prefix, maxBodySize] : limits.maxBodySizeByPath) {
+      if (path.startsWith(prefix)) {
+        return maxBodySize;
+      }
+    }
+    return limits.maxBodySize;
+  }
+
+  bool exceeds(qint64 size, qint64 maxBodySize) {
+    return maxBodySize > 0 and size > maxBodySize;
+  }
+
+  /*
+   * Appends bytes from offset up to end of line to line.
+   * Returns true once line is complete.
+   */
+  bool takeLine(QByteArray& line, const QByteArray& bytes, qint64& offset) {
+    auto end = bytes.indexOf('\n', offset);
+    auto taken = (end < 0 ? bytes.size() : end + 1) - offset;
+    line.append(QByteArrayView(bytes).sliced(offset, taken));
+    offset += taken;
+    return end >= 0;
+  }
+
+  /*
+   * Expects body of request which head has just arrived.
+   * Returns false if its Content-Length exceeds the limit.
+   */
+  bool startBody(Intake& intake, const Limits& limits) {
+    auto head = std::exchange(intake.line, {});
+    intake.maxBodySize = maxBodySizeOf(pathOf(head), limits);
+    intake.bodyReceived = 0;
+    if (isChunked(head)) {
+      intake.stage = Stage::ChunkSize;
+      return true;
+    }
+
+    auto contentLength = contentLengthOf(head);
+    intake.remaining = std::max<qint64>(contentLength, 0);
+    intake.stage = intake.remaining > 0 ? Stage::Body : Stage::Head;
+    return not exceeds(contentLength, intake.maxBodySize);
+  }
+
+  /*
+   * Follows framing of requests through arrived bytes. Request ends
+   * after its Content-Length bytes or after its last chunk and trailer,
+   * bytes after it start head of next request.
+   * Bytes are peeked only where framing has to be read,
+   * so large bodies are merely counted.
+   * Gives start of request which body exceeds its limit within arrived
+   * bytes, 0 if it started before them.
+   */
+  std::optional<qint64> follow(Intake& intake,
+                               QTcpSocket& socket,
+                               qint64 arrived,
+                               const Limits& limits) {
+    QByteArray bytes;
+    qint64 offset = 0;
+    qint64 requestStart = 0;
+    while (offset < arrived) {
+      if (Stage::Head == intake.stage and intake.line.isEmpty()) {
+        requestStart = offset;
+      }
+      if (Stage::Body == intake.stage or Stage::ChunkData == intake.stage) {
+        auto taken = std::min(arrived - offset, intake.remaining);
+        intake.remaining -= taken;
+        offset += taken;
+        if (0 == intake.remaining) {
+          intake.stage =
+              Stage::Body == intake.stage ? Stage::Head : Stage::ChunkEnd;
+        }
+        continue;
+      }
+      if (Stage::Unframed == intake.stage) {
+        intake.bodyReceived += arrived - offset;
+        if (exceeds(intake.bodyReceived, intake.maxBodySize)) {
+          return requestStart;
+        }
+        return std::nullopt;
+      }
+
+      if (bytes.isNull()) {
+        bytes = socket.peek(arrived);
+      }
+      auto seen = intake.line.size();
+      if (Stage::Head == intake.stage) {
+        intake.line.append(QByteArrayView(bytes).sliced(
+            offset, std::min(arrived - offset, maxHeadSize - seen)));
+        auto headersEnd =
+            intake.line.indexOf("\r\n\r\n", std::max<qint64>(seen - 3, 0));
+        if (headersEnd >= 0) {
+          offset += headersEnd + 4 - seen;
+          intake.line.truncate(headersEnd + 4);
+          if (not startBody(intake, limits)) {
+            return requestStart;
+          }
+        } else if (intake.line.size() < maxHeadSize) {
+          offset = arrived;
+        } else {
+          offset += maxHeadSize - seen;
+          if (not startBody(intake, limits)) {
+            return requestStart;
+          }
+          intake.stage = Stage::Unframed;
+        }
+        continue;
+      }
+
+      if (not takeLine(intake.line, bytes, offset)) {
+        if (intake.line.size() >= maxHeadSize) {
+          intake.line.clear();
+          intake.stage = Stage::Unframed;
+        }
+        continue;
+      }
+      auto line = std::exchange(intake.line, {});
+      if (Stage::ChunkEnd == intake.stage) {
+        intake.stage = Stage::ChunkSize;
+      } else if (Stage::Trailer == intake.stage) {
+        if (line.trimmed().isEmpty()) {
+          intake.stage = Stage::Head;
+        }
+      } else if (auto size = chunkSizeOf(line); size < 0) {
+        intake.stage = Stage::Unframed;
+      } else if (0 == size) {
+        intake.stage = Stage::Trailer;
+      } else {
+        // Declared size is checked, so chunk is rejected before it arrives
+        intake.bodyReceived += size;
+        intake.remaining = size;
+        intake.stage = Stage::ChunkData;
+        if (exceeds(intake.bodyReceived, intake.maxBodySize)) {
+          return requestStart;
+        }
+      }
+    }
+    return std::nullopt;
+  }
+
+  /*
+   * Drops arrived bytes from start of rejected request, so HTTP server
+   * reads only requests preceding it, and once server has routed them,
+   * responds 413 and closes connection.
+   */
+  void reject(QTcpSocket& socket,
+              Intake& intake,
+              qint64 arrived,
+              qint64 requestStart) {
+    intake.rejected = true;
+    intake.line.clear();
+    if (0 == requestStart) {
+      socket.skip(arrived);
+    } else {
+      // Socket drops bytes only from the front, so kept ones are put back
+      auto bytes = socket.read(arrived);
+      for (auto byte = requestStart; byte-- > 0;) {
+        socket.ungetChar(bytes[byte]);
+      }
+    }
+
+    QMetaObject::invokeMethod(
+        &socket,
+        [&socket] {
+          static const auto response = test::api::makeRawResponse(
+              test::api::Error::PayloadExceedsLimit);
+          socket.write(response);
+          socket.disconnectFromHost();
+        },
+        Qt::QueuedConnection);
+  }
+
+  /*
+   * Connected before HTTP server takes socket, so it sees every chunk
+   * of bytes before server reads it, as slots are called in order
+   * they were connected. HTTP server reads all available bytes each time,
+   * so bytes available here are the ones just arrived.
+   */
+  void limitRequestBody(QTcpSocket& socket,
+                        std::shared_ptr<const Limits> limits) {
+    auto* intake = new Intake(socket);
+
+    QObject::connect(
+        &socket,
+        &QTcpSocket::readyRead,
+        intake,
+        [&socket, intake, limits = std::move(limits)] {
+#if QT_VERSION < QT_VERSION_CHECK(6, 5, 0)
+          receivingSocket = &socket;
+#endif
+          auto arrived = socket.bytesAvailable();
+          Q_ASSERT_X(arrived > 0,
+                     "LimitingTcpServer",
+                     "request bytes were read before their size was checked");
+          if (intake->rejected) {
+            socket.skip(arrived);
+            return;
+          }
+
+          if (auto requestStart = follow(*intake, socket, arrived, *limits)) {
+            reject(socket, *intake, arrived, *requestStart);
+          }
+        });
+  }
+} // namespace
+
+namespace test::api {
+  LimitingTcpServer::LimitingTcpServer(Limits limits, QObject* parent)
+    : QTcpServer(parent)
+    , m_limits(std::make_shared<const Limits>(std::move(limits))) { }
+
+  void LimitingTcpServer::takeConnection(qintptr socketDescriptor) {
+    auto* socket = new QTcpSocket(this);
+    if (not socket->setSocketDescriptor(socketDescriptor)) {
+      delete socket;
+      return;
+    }
+
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    Peer peer{ socket->localPort(), socket->peerAddress(), socket->peerPort() };
+    connections.insert(peer, socket);
+    connect(socket, &QObject::destroyed, [peer] { connections.remove(peer); });
+#endif
+
+    limitRequestBody(*socket, m_limits);
+    addPendingConnection(socket);
+  }
+
+  QTcpSocket*
+  LimitingTcpServer::connectionOf(const QHttpServerRequest& request) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 5, 0)
+    return connections.value(
+        { request.localPort(), request.remoteAddress(), request.remotePort() });
+#else
+    Q_UNUSED(request);
+    return receivingSocket;
+#endif
+  }
+
+  void LimitingTcpServer::incomingConnection(qintptr socketDescriptor) {
+    takeConnection(socketDescriptor);
+  }
+} // namespace test::api
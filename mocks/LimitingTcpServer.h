@@ -0,0 +1,58 @@
+#pragma once
+#include <QByteArray>
+#include <QHttpServerRequest>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace test::api {
+  /*
+   * TCP server limiting size of request bodies on connections it publishes.
+   * Bytes are watched as they arrive, before HTTP server buffers them,
+   * following Content-Length and chunked framing to where each request
+   * ends, so pipelined requests are limited one by one.
+   * Request declaring larger Content-Length, or chunks larger in total
+   * than allowed, gets 413 and its connection is closed,
+   * so oversized body is never buffered or parsed.
+   * Requests pipelined before rejected one are still served.
+   * Limit of 0 disables the check.
+   */
+  class LimitingTcpServer : public QTcpServer {
+
+  public:
+    struct Limits {
+      qint64 maxBodySize = 0;
+
+      /*
+       * Overrides maxBodySize for requests to paths starting with prefix.
+       */
+      std::vector<std::pair<QByteArray, qint64>> maxBodySizeByPath;
+    };
+
+    explicit LimitingTcpServer(Limits limits, QObject* parent = nullptr);
+
+    /*
+     * Publishes connection accepted elsewhere,
+     * so server doesn't need to listen by itself.
+     */
+    void takeConnection(qintptr socketDescriptor);
+
+    /*
+     * Connection request arrived on, nullptr if it is closed.
+     * Connections are looked up by their addresses, which requests carry
+     * since Qt 6.5, so request routed after ones pipelined before it
+     * finds its own. With older Qt it is connection which bytes were read
+     * last on calling thread.
+     * Valid on thread of server which took connection, i.e. in routes.
+     */
+    static QTcpSocket* connectionOf(const QHttpServerRequest& request);
+
+  protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+  private:
+    std::shared_ptr<const Limits> m_limits;
+  };
+} // namespace test::api
@@ -0,0 +1,211 @@
+#include "Metrics.h"
+
+#include "Responses.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace {
+  std::size_t bucketOf(std::chrono::microseconds latency) {
+    auto micros = static_cast<quint64>(std::max<qint64>(latency.count(), 1));
+    // Smallest exponent with micros <= 2^exponent
+    auto exponent = std::bit_width(micros - 1);
+    if (exponent <= test::api::Metrics::firstBucketExponent) {
+      return 0;
+    }
+    return std::min<std::size_t>(
+        exponent - test::api::Metrics::firstBucketExponent,
+        test::api::Metrics::bucketCount - 1);
+  }
+
+  QByteArray upperBoundOf(std::size_t bucket) {
+    if (bucket + 1 == test::api::Metrics::bucketCount) {
+      return "+Inf";
+    }
+    auto micros = quint64{ 1 }
+                  << (test::api::Metrics::firstBucketExponent + bucket);
+    return QByteArray::number(micros / 1e6, 'g', 7);
+  }
+
+  QByteArray labelsOf(const test::api::Metrics::Route& route) {
+    return "route=\"" + route.name().toUtf8() + '"';
+  }
+} // namespace
+
+namespace test::api {
+  Metrics::Route::Route(QString name)
+    : m_name(std::move(name)) { }
+
+  void Metrics::Route::record(State state,
+                              int statusCode,
+                              std::chrono::microseconds latency) noexcept {
+    m_requestsByState[static_cast<std::size_t>(state)].fetch_add(
+        1, std::memory_order_relaxed);
+    auto status = static_cast<std::size_t>(statusCode - firstStatusCode);
+    if (status < statusCodeCount) {
+      m_responsesByStatus[status].fetch_add(1, std::memory_order_relaxed);
+    }
+    m_latencyBuckets[bucketOf(latency)].fetch_add(1,
+                                                  std::memory_order_relaxed);
+    m_latencySum.fetch_add(std::max<qint64>(latency.count(), 0),
+                           std::memory_order_relaxed);
+  }
+
+  const QString& Metrics::Route::name() const noexcept {
+    return m_name;
+  }
+
+  quint64 Metrics::Route::requests() const noexcept {
+    quint64 total = 0;
+    for (const auto& requests : m_requestsByState) {
+      total += requests.load(std::memory_order_relaxed);
+    }
+    return total;
+  }
+
+  quint64 Metrics::Route::requests(State state) const noexcept {
+    return m_requestsByState[static_cast<std::size_t>(state)].load(
+        std::memory_order_relaxed);
+  }
+
+  quint64 Metrics::Route::responses(int statusCode) const noexcept {
+    auto status = static_cast<std::size_t>(statusCode - firstStatusCode);
+    if (status >= statusCodeCount) {
+      return 0;
+    }
+    return m_responsesByStatus[status].load(std::memory_order_relaxed);
+  }
+
+  std::chrono::microseconds Metrics::Route::latency() const noexcept {
+    return std::chrono::microseconds(
+        m_latencySum.load(std::memory_order_relaxed));
+  }
+
+  void Metrics::Route::recordSkippedDelay() noexcept {
+    m_skippedDelays.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  quint64 Metrics::Route::skippedDelays() const noexcept {
+    return m_skippedDelays.load(std::memory_order_relaxed);
+  }
+
+  Metrics::Route& Metrics::route(const QString& name) {
+    std::lock_guard lock{ m_mutex };
+    auto existing = std::find_if(
+        m_routes.begin(), m_routes.end(), [&name](const Route& route) {
+          return route.name() == name;
+        });
+    if (existing != m_routes.end()) {
+      return *existing;
+    }
+    return m_routes.emplace_back(name);
+  }
+
+  const Metrics::Route* Metrics::find(const QString& name) const {
+    std::lock_guard lock{ m_mutex };
+    auto existing = std::find_if(
+        m_routes.begin(), m_routes.end(), [&name](const Route& route) {
+          return route.name() == name;
+        });
+    return existing == m_routes.end() ? nullptr : &*existing;
+  }
+
+  void Metrics::recordScan(std::size_t rows,
+                           std::chrono::nanoseconds duration) noexcept {
+    m_scannedRows.fetch_add(rows, std::memory_order_relaxed);
+    m_scanNanoseconds.fetch_add(std::max<qint64>(duration.count(), 0),
+                                std::memory_order_relaxed);
+  }
+
+  quint64 Metrics::scannedRows() const noexcept {
+    return m_scannedRows.load(std::memory_order_relaxed);
+  }
+
+  QByteArray Metrics::exposition() const {
+    std::lock_guard lock{ m_mutex };
+    QByteArray text;
+
+    text += "# HELP api_mock_requests_total "
+            "Requests served by route and API Mock state.\n"
+            "# TYPE api_mock_requests_total counter\n";
+    for (const auto& route : m_routes) {
+      for (std::size_t state = 0; state < stateCount; ++state) {
+        auto requests =
+            route.m_requestsByState[state].load(std::memory_order_relaxed);
+        if (0 == requests) {
+          continue;
+        }
+        text += "api_mock_requests_total{" + labelsOf(route) + ",state=\"" +
+                nameOf(static_cast<State>(state)) + "\"} " +
+                QByteArray::number(requests) + '\n';
+      }
+    }
+
+    text += "# HELP api_mock_responses_total "
+            "Responses sent by route and status code.\n"
+            "# TYPE api_mock_responses_total counter\n";
+    for (const auto& route : m_routes) {
+      for (std::size_t status = 0; status < Route::statusCodeCount; ++status) {
+        auto responses =
+            route.m_responsesByStatus[status].load(std::memory_order_relaxed);
+        if (0 == responses) {
+          continue;
+        }
+        text += "api_mock_responses_total{" + labelsOf(route) +
+                ",status=\"" +
+                QByteArray::number(status + Route::firstStatusCode) + "\"} " +
+                QByteArray::number(responses) + '\n';
+      }
+    }
+
+    // Counters are read one by one, so histogram may be off by requests
+    // recorded meanwhile, which Prometheus tolerates
+    text += "# HELP api_mock_request_duration_seconds "
+            "Time from routing request to sending response.\n"
+            "# TYPE api_mock_request_duration_seconds histogram\n";
+    for (const auto& route : m_routes) {
+      auto labels = labelsOf(route);
+      quint64 cumulative = 0;
+      for (std::size_t bucket = 0; bucket < bucketCount; ++bucket) {
+        cumulative +=
+            route.m_latencyBuckets[bucket].load(std::memory_order_relaxed);
+        text += "api_mock_request_duration_seconds_bucket{" + labels +
+                ",le=\"" + upperBoundOf(bucket) + "\"} " +
+                QByteArray::number(cumulative) + '\n';
+      }
+      text += "api_mock_request_duration_seconds_sum{" + labels + "} " +
+              QByteArray::number(route.latency().count() / 1e6, 'g', 12) +
+              '\n';
+      text += "api_mock_request_duration_seconds_count{" + labels + "} " +
+              QByteArray::number(cumulative) + '\n';
+    }
+
+    text += "# HELP api_mock_skipped_delays_total "
+            "Responses sent without delay of route profile.\n"
+            "# TYPE api_mock_skipped_delays_total counter\n";
+    for (const auto& route : m_routes) {
+      if (auto skipped = route.skippedDelays(); 0 != skipped) {
+        text += "api_mock_skipped_delays_total{" + labelsOf(route) + "} " +
+                QByteArray::number(skipped) + '\n';
+      }
+    }
+
+    text += "# HELP api_mock_scanned_rows_total "
+            "Rows scanned by range queries.\n"
+            "# TYPE api_mock_scanned_rows_total counter\n"
+            "api_mock_scanned_rows_total " +
+            QByteArray::number(m_scannedRows.load(std::memory_order_relaxed)) +
+            '\n';
+    text += "# HELP api_mock_scan_duration_seconds_total "
+            "Time spent scanning columns by range queries.\n"
+            "# TYPE api_mock_scan_duration_seconds_total counter\n"
+            "api_mock_scan_duration_seconds_total " +
+            QByteArray::number(
+                m_scanNanoseconds.load(std::memory_order_relaxed) / 1e9,
+                'g',
+                12) +
+            '\n';
+
+    return text;
+  }
+} // namespace test::api
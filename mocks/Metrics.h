@@ -0,0 +1,107 @@
+#pragma once
+#include "MockApiServer.h"
+
+#include <QByteArray>
+#include <QString>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+namespace test::api {
+  /*
+   * Counters of requests served by API Mock,
+   * exposed at /metrics in Prometheus text format.
+   * Routes are added while routes are registered,
+   * requests are counted without locks.
+   */
+  class Metrics {
+
+  public:
+    using State = MockApiServer::State;
+
+    static constexpr std::size_t stateCount =
+        static_cast<std::size_t>(State::CableTypeReferencedByOtherEntities) + 1;
+
+    /*
+     * Upper bounds of latency buckets are powers of 2 microseconds,
+     * from 16 us to about 8.4 s, slower requests fall into +Inf bucket.
+     */
+    static constexpr int firstBucketExponent = 4;
+    static constexpr std::size_t bucketCount = 21;
+
+    class Route {
+
+    public:
+      explicit Route(QString name);
+
+      void record(State state,
+                  int statusCode,
+                  std::chrono::microseconds latency) noexcept;
+
+      const QString& name() const noexcept;
+      quint64 requests() const noexcept;
+      quint64 requests(State state) const noexcept;
+      quint64 responses(int statusCode) const noexcept;
+
+      /*
+       * Sum of latencies of all requests.
+       */
+      std::chrono::microseconds latency() const noexcept;
+
+      /*
+       * Responses sent without delay of route profile,
+       * as their connection was not found to bind delay to.
+       */
+      void recordSkippedDelay() noexcept;
+      quint64 skippedDelays() const noexcept;
+
+    private:
+      friend class Metrics;
+
+      static constexpr int firstStatusCode = 100;
+      static constexpr std::size_t statusCodeCount = 500;
+
+      QString m_name;
+      std::array<std::atomic<quint64>, stateCount> m_requestsByState{};
+      std::array<std::atomic<quint64>, statusCodeCount> m_responsesByStatus{};
+      std::array<std::atomic<quint64>, bucketCount> m_latencyBuckets{};
+      std::atomic<quint64> m_latencySum = 0;
+      std::atomic<quint64> m_skippedDelays = 0;
+    };
+
+    Metrics() = default;
+    ~Metrics() = default;
+
+    /*
+     * Counters of route, added on first use.
+     * Stays valid for lifetime of metrics.
+     */
+    Route& route(const QString& name);
+
+    /*
+     * Gives nullptr for route never added.
+     */
+    const Route* find(const QString& name) const;
+
+    /*
+     * Column scan of range query, rows scanned per second are
+     * rate of scanned rows over rate of scan time.
+     */
+    void recordScan(std::size_t rows,
+                    std::chrono::nanoseconds duration) noexcept;
+    quint64 scannedRows() const noexcept;
+
+    /*
+     * All counters in Prometheus text exposition format.
+     */
+    QByteArray exposition() const;
+
+  private:
+    mutable std::mutex m_mutex;
+    std::deque<Route> m_routes;
+    std::atomic<quint64> m_scannedRows = 0;
+    std::atomic<quint64> m_scanNanoseconds = 0;
+  };
+} // namespace test::api
@@ -1,551 +1,1039 @@
 #include "MockApiServer.h"
 
+#include "AccessLog.h"
+#include "Authorization.h"
+#include "DefaultCableType.h"
+#include "LimitingTcpServer.h"
+#include "Metrics.h"
+#include "RangeQuery.h"
+#include "Responses.h"
+#include "Seeding.h"
+#include "Snapshot.h"
+#include "Validation.h"
+
 #include <QCoreApplication>
 #include <QDebug>
 #include <QHostAddress>
 #include <QHttpServerRequest>
 #include <QHttpServerResponse>
+#include <QJsonArray>
 #include <QJsonObject>
-#include <algorithm>
+#include <QTimer>
+#include <QUrlQuery>
 #include <qjsondocument.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
 #include <stdexcept>
-#include <unordered_map>
+#include <variant>
 
 namespace {
   /*
-   * Predefined map of user ids to their hardcoded JWT token.
-   * Enough for test purpose to imitate logged in user.
+   * Metadata API assigns to created cable types.
+   */
+  const QJsonObject& generatedMetadata() {
+    static const auto metadata = QJsonDocument::fromJson(R"({
+        "created": "2020-10-13T21:31:51.259Z",
+        "modified": "2020-10-13T21:31:51.259Z",
+        "user": {
+          "id": "5f3bc9e2502422053e08f9f1",
+          "username": "test@reelsense.io"
+        }
+      })").object();
+    return metadata;
+  }
+
+  static constexpr auto cursorEncoding =
+      QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+
+  /*
+   * Cursor of cable type list is bound to customer code it was made for,
+   * so it can't be used to continue listing of another customer.
+   */
+  QString makeCursor(const QString& customerCode, const QString& afterId) {
+    return QString::fromLatin1(
+        (customerCode + '\n' + afterId).toUtf8().toBase64(cursorEncoding));
+  }
+
+  std::optional<QString> afterIdOf(const QString& cursor,
+                                   const QString& customerCode) {
+    auto decoded = QByteArray::fromBase64Encoding(
+        cursor.toLatin1(),
+        cursorEncoding | QByteArray::AbortOnBase64DecodingErrors);
+    if (not decoded) {
+      return std::nullopt;
+    }
+
+    auto fields = QString::fromUtf8(*decoded).split('\n');
+    if (2 != fields.size() or customerCode != fields.front()) {
+      return std::nullopt;
+    }
+    return fields.back();
+  }
+
+  /*
+   * Range predicates of query, e.g. "voltage.min=10&voltage.max=20",
+   * bounds of the same field are merged into one predicate.
+   * Query items other than bounds are rejected, unless they are ignored.
+   */
+  std::optional<std::vector<test::api::RangePredicate>>
+  rangePredicatesOf(const QUrlQuery& query, const QStringList& ignored) {
+    std::vector<test::api::RangePredicate> predicates;
+    for (const auto& [key, value] : query.queryItems(QUrl::FullyDecoded)) {
+      if (ignored.contains(key)) {
+        continue;
+      }
+
+      auto isMin = key.endsWith(".min");
+      if (not isMin and not key.endsWith(".max")) {
+        return std::nullopt;
+      }
+      auto field = test::api::numericFieldOf(key.chopped(4));
+      bool valid = false;
+      auto bound = value.toDouble(&valid);
+      if (not field or not valid) {
+        return std::nullopt;
+      }
+
+      auto predicate = std::find_if(
+          predicates.begin(), predicates.end(), [&field](const auto& range) {
+            return range.field == *field;
+          });
+      if (predicate == predicates.end()) {
+        predicate = predicates.insert(predicates.end(),
+                                      test::api::RangePredicate{ *field });
+      }
+      if (isMin) {
+        predicate->min = std::max(predicate->min, bound);
+      } else {
+        predicate->max = std::min(predicate->max, bound);
+      }
+    }
+    if (predicates.empty()) {
+      return std::nullopt;
+    }
+    return predicates;
+  }
+
+  /*
+   * Members of query response with matching cable types:
+   * their ids or documents and count of all matching ones.
    */
-  static const std::unordered_map<QString, QString> users = {
-    {"superuser",
-     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
-     "eyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
-     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
-
-    {    "admin",
-     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
-     "fyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
-     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
-
-    {     "user",
-     "eyJhbGciOiJIUzI1NiIsInR5cCI6IkpXVCJ9."
-     "gyJzdWIiOiIxMjM0NTY3ODkwIiwibmFtZSI6IkpvaG4gRG9lIiwiaWF0IjoxNTE2MjM5MDIy"
-     "fQ.SflKxwRJSMeKKF2QT4fwpMeJf36POk6yJV_adQssw5c"},
+  QByteArray
+  selectionOf(const std::vector<QString>& ids,
+              const std::vector<test::api::CableTypeStore::Entry>& cableTypes,
+              bool documents,
+              std::size_t matched) {
+    QByteArray selection;
+    if (documents) {
+      selection += R"("cableTypes":[)";
+      for (const auto& cableType : cableTypes) {
+        if (&cableType != &cableTypes.front()) {
+          selection += ',';
+        }
+        selection += cableType->json();
+      }
+      selection += ']';
+    } else {
+      selection += R"("ids":)" +
+                   QJsonDocument(QJsonArray::fromStringList(
+                                     QStringList(ids.begin(), ids.end())))
+                       .toJson(QJsonDocument::Compact);
+    }
+    selection += R"(,"matched":)" +
+                 QByteArray::number(static_cast<qulonglong>(matched));
+    return selection;
+  }
+
+  /*
+   * Count of items query asks for with "limit", defaultLimit if it doesn't,
+   * capped by page size.
+   */
+  std::variant<qsizetype, test::api::Error>
+  pageLimitOf(const QUrlQuery& query, qsizetype defaultLimit) {
+    auto limit = defaultLimit;
+    if (query.hasQueryItem("limit")) {
+      bool valid = false;
+      limit = query.queryItemValue("limit").toLongLong(&valid);
+      if (not valid or limit < 1) {
+        return test::api::Error::InvalidPageSize;
+      }
+    }
+    return std::min(limit, test::api::MockApiServer::maxPageSize);
+  }
+
+  /*
+   * What query asks for and how many, e.g. "select=documents&limit=20",
+   * selecting ids and default page size if not requested explicitly.
+   */
+  struct Selection {
+    qsizetype limit = test::api::MockApiServer::defaultPageSize;
+    bool documents = false;
   };
 
-  QHttpServerResponse makeResponse(QString&& rawBody,
-                                   QHttpServerResponse::StatusCode statusCode) {
-    return QHttpServerResponse(
-        QJsonDocument::fromJson(rawBody.toUtf8()).object(), statusCode);
+  std::variant<Selection, test::api::Error>
+  selectionQueryOf(const QUrlQuery& query) {
+    const auto select = query.queryItemValue("select");
+    if (not select.isEmpty() and "ids" != select and "documents" != select) {
+      return test::api::Error::InvalidSelection;
+    }
+
+    auto limit = pageLimitOf(query, test::api::MockApiServer::defaultPageSize);
+    if (const auto* error = std::get_if<test::api::Error>(&limit)) {
+      return *error;
+    }
+    return Selection{ .limit = std::get<qsizetype>(limit),
+                      .documents = "documents" == select };
+  }
+
+  /*
+   * Group of statistics, min, max and mean are left out
+   * for fields none of its cable types has.
+   */
+  QJsonObject toJson(const test::api::GroupSummary& group,
+                     const QString& keyName) {
+    QJsonObject json{ { keyName, group.key },
+                      { "count", static_cast<qint64>(group.cableTypes) } };
+    for (std::size_t i = 0; i < test::api::aggregatedFields.size(); ++i) {
+      const auto& summary = group.fields[i];
+      QJsonObject field{ { "count", static_cast<qint64>(summary.count) },
+                         { "sum", summary.sum } };
+      if (0 != summary.count) {
+        field["min"] = summary.min;
+        field["max"] = summary.max;
+        field["mean"] = summary.mean;
+      }
+      json[test::api::pathOf(test::api::aggregatedFields[i])] = field;
+    }
+    return json;
+  }
+
+  QJsonArray toJson(const std::vector<test::api::GroupSummary>& groups,
+                    const QString& keyName) {
+    QJsonArray json;
+    for (const auto& group : groups) {
+      json.append(toJson(group, keyName));
+    }
+    return json;
+  }
+
+  test::api::LimitingTcpServer::Limits
+  limitsOf(const test::api::MockApiServer::Options& options) {
+    return { options.maxBodySize,
+             { { "/cable/type/bulk", options.maxBufferedBulkBodySize } } };
   }
 
   using State = test::api::MockApiServer::State;
-  QHttpServerResponse responseByState(State state) {
+  using RouteProfile = test::api::MockApiServer::RouteProfile;
 
-    switch (state) {
+  /*
+   * What happens to single request to profiled route.
+   */
+  struct Outcome {
+    std::optional<State> fault;
+    std::chrono::microseconds delay{ 0 };
+  };
 
-    case State::Unauthorized:
-      return makeResponse(R"({"cause": "Unauthorized"})",
-                          QHttpServerResponse::StatusCode::Unauthorized);
+  Outcome decide(const RouteProfile& profile,
+                 std::chrono::steady_clock::duration sinceStart) {
+    thread_local std::mt19937_64 random{ std::random_device{}() };
 
-    case State::AttemptToAccessAnotherCustomerData:
-      return makeResponse(
-          R"({"cause": "Attempt to access another customer data"})",
-          QHttpServerResponse::StatusCode::Forbidden);
+    const auto* faults = &profile.faults;
+    const auto* delays = &profile.latency;
+    if (profile.burst and profile.burst->period.count() > 0 and
+        sinceStart % profile.burst->period < profile.burst->length) {
+      faults = &profile.burst->faults;
+      delays = &profile.burst->latency;
+    }
 
-    case State::NonExistingCustomerId:
-      return makeResponse(R"({"cause": "Non existing customer id specified"})",
-                          QHttpServerResponse::StatusCode::NotFound);
+    // Single roll picks at most one fault, probabilities add up in order
+    Outcome outcome;
+    auto roll = std::uniform_real_distribution<double>(0.0, 1.0)(random);
+    for (const auto& fault : *faults) {
+      roll -= fault.probability;
+      if (roll < 0.0) {
+        outcome.fault = fault.state;
+        if (not std::holds_alternative<std::monostate>(fault.latency)) {
+          delays = &fault.latency;
+        }
+        break;
+      }
+    }
+    outcome.delay = test::api::latency::sample(*delays, random);
+    return outcome;
+  }
 
-    case State::CableTypeAlreadyExists:
-      return makeResponse(R"({"cause": "Cable type already exists"})",
-                          QHttpServerResponse::StatusCode::Conflict);
+  void send(QHttpServerResponder&& responder,
+            const QHttpServerResponse& response) {
+#if QT_VERSION < QT_VERSION_CHECK(6, 5, 0)
+    response.write(std::move(responder));
+#else
+    responder.sendResponse(response);
+#endif
+  }
 
-    case State::BusinessRulesViolated:
-      return makeResponse(R"({"cause": "Business rules violated"})",
-                          QHttpServerResponse::StatusCode::PreconditionFailed);
+  int statusCodeOf(const QHttpServerResponse& response) {
+    return static_cast<int>(response.statusCode());
+  }
 
-    case State::DatabaseRejectedTransaction:
-      return makeResponse(R"({"cause": "Database rejected transaction"})",
-                          QHttpServerResponse::StatusCode::ExpectationFailed);
+  std::chrono::microseconds
+  microsecondsSince(std::chrono::steady_clock::time_point startedAt) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - startedAt);
+  }
 
-    case State::DatabaseUnhandledError:
-      return makeResponse(R"({"cause": "Database unhandled error"})",
-                          QHttpServerResponse::StatusCode::UnprocessableEntity);
+  /*
+   * Counts response about to be sent, record tells how it was served.
+   */
+  void account(test::api::Metrics::Route& routeMetrics,
+               test::api::AccessLog* accessLog,
+               test::api::AccessLog::Record record,
+               std::chrono::steady_clock::time_point startedAt) {
+    record.serverTime = microsecondsSince(startedAt);
+    routeMetrics.record(record.state, record.statusCode, record.serverTime);
+    if (nullptr != accessLog) {
+      record.sentAt = std::chrono::system_clock::now();
+      accessLog->write(record);
+    }
+  }
 
-    case State::DatabaseRequestTimeout:
-      return makeResponse(R"({"cause": "Database request timeout"})",
-                          QHttpServerResponse::StatusCode::FailedDependency);
+  /*
+   * Response waiting for its delay to pass.
+   * Timer keeps it in copyable std::function, hence shared.
+   */
+  struct DelayedResponse {
+    DelayedResponse(QHttpServerResponder&& responder,
+                    QHttpServerResponse&& response)
+      : responder(std::move(responder))
+      , response(std::move(response)) { }
+
+    QHttpServerResponder responder;
+    QHttpServerResponse response;
+  };
+} // namespace
 
-    case State::DatabaseConnectionError:
-      return makeResponse(R"({"cause": "Database connection error"})",
-                          QHttpServerResponse::StatusCode::InternalServerError);
+namespace test::api {
+  MockApiServer::MockApiServer(State state)
+    : MockApiServer(state, Options{}) { }
+
+  MockApiServer::MockApiServer(State state, Options options)
+    : m_state(state)
+    , m_routeProfiles(std::move(options.routeProfiles))
+    , m_startedAt(std::chrono::steady_clock::now())
+    , m_metrics(std::make_unique<Metrics>()) {
+    if (not options.accessLogPath.isEmpty()) {
+      m_accessLog = std::make_unique<AccessLog>(options.accessLogPath,
+                                                options.accessLogCapacity);
+    }
 
-    case State::TooLargePayload:
-      return makeResponse(R"({"cause": "Too large payload"})",
-                          QHttpServerResponse::StatusCode::InsufficientStorage);
+    // Serialize error bodies before first request arrives
+    prepareResponses();
+    m_store.insert(QJsonDocument::fromJson(defaultCableTypeData).object());
+    if (not options.snapshotPath.isEmpty()) {
+      loadSnapshot(m_store, options.snapshotPath);
+    }
+    if (not options.seedPath.isEmpty()) {
+      auto seeded = seedFromNdjson(m_store, options.seedPath);
+      if (0 != seeded.rejected) {
+        qWarning() << "API Mock skipped" << seeded.rejected
+                   << "cable types of" << options.seedPath;
+      }
+    }
 
-    default:
-      break;
+    if (0 == options.workerThreads) {
+      registerRoutes(m_server);
+      auto* tcpServer = new LimitingTcpServer(limitsOf(options));
+      if (tcpServer->listen(QHostAddress::LocalHost, options.port)) {
+        m_server.bind(tcpServer);
+        m_port = tcpServer->serverPort();
+      } else {
+        delete tcpServer;
+      }
+    } else {
+      m_workerPool = std::make_unique<WorkerPool>(
+          options.workerThreads,
+          limitsOf(options),
+          [this](QHttpServer& server) { registerRoutes(server); });
+      if (m_workerPool->listen(QHostAddress::LocalHost, options.port)) {
+        m_port = m_workerPool->serverPort();
+      }
     }
 
-    return makeResponse(R"({"cause": "Unexpected error"})",
-                        QHttpServerResponse::StatusCode::BadGateway);
-  };
+    if (0 == m_port) {
+      throw std::runtime_error(
+          QString("API Mock failed to listen on port %1")
+              .arg(options.port)
+              .toStdString());
+    }
+  }
 
-  bool validateRotationFrequencyUnitValues(QString&& value) noexcept {
-    static constexpr std::array<std::string, 3> rotationFrequencyUnitValues = {
-      "d", "w", "m"
-    };
+  MockApiServer::~MockApiServer() = default;
 
-    return std::none_of(
-        rotationFrequencyUnitValues.begin(),
-        rotationFrequencyUnitValues.end(),
-        [valueToValidate = value.toStdString()](const auto& value) -> bool {
-          return value == valueToValidate;
-        });
+  CableTypeStore& MockApiServer::store() noexcept {
+    return m_store;
   }
 
-  QString
-  extractUserTokenFromHeaders(QList<QPair<QByteArray, QByteArray>>&& headers) {
-    for (const auto& [key, value] : headers) {
-      if ("Authorization" == key) {
-        return value;
-      }
+  quint16 MockApiServer::port() const noexcept {
+    return m_port;
+  }
+
+  const Metrics& MockApiServer::metrics() const noexcept {
+    return *m_metrics;
+  }
+
+  QUrl MockApiServer::url(const QString& path) const {
+    static const auto host = QHostAddress(QHostAddress::LocalHost).toString();
+    return QUrl(
+        QString("http://%1:%2%3").arg(host, QString::number(m_port), path));
+  }
+
+  std::optional<Error> MockApiServer::createCableType(QJsonObject& cableType) {
+    if (auto error = validateNewCableType(cableType)) {
+      return error;
     }
-    return {};
+
+    cableType["metadata"] = generatedMetadata();
+    cableType["id"] = m_store.create(cableType);
+    return std::nullopt;
   }
 
-  static constexpr const char defaultCableTypeData[] = R"(
-    {
-      "id": "5f3bc9e2502422053e08f9f1",
-      "identifier": "10-al-1c-trxple",
-      "catid": 1622475,
-      "diameter": {
-        "published": {
-          "value": 22.43,
-          "unit": "mAh"
-        },
-        "actual": {
-          "value": 22.43,
-          "unit": "mAh"
-        }
-      },
-      "conductor": {
-        "number": 0,
-        "size": {
-          "value": 22.43,
-          "unit": "mAh"
-        }
-      },
-      "insulation": {
-        "type": "string",
-        "shield": "string",
-        "jacket": "string",
-        "thickness": {
-          "value": 22.43,
-          "unit": "mAh"
-        }
-      },
-      "material": {
-        "aluminum": 0,
-        "copper": 0,
-        "weight": {
-          "net": {
-            "value": 22.43,
-            "unit": "mAh"
-          },
-          "calculated": {
-            "value": 22.43,
-            "unit": "mAh"
-          }
-        }
-      },
-      "currentPrice": {
-        "value": 22.43,
-        "unit": "USD"
-      },
-      "voltage": {
-        "value": 22.43,
-        "unit": "mAh"
-      },
-      "rotationFrequency": {
-        "value": 22.43,
-        "unit": "m"
-      },
-      "manufacturer": {
-        "id": "5f3bc9e2502422053e08f9f1",
-        "name": "Kerite"
-      },
-      "properties": [
-        {
-          "name": "manufacturedBy",
-          "value": {
-            "string": "string value",
-            "number": 1234.56
-          }
+  template <typename... Args>
+  MockApiServer::ResponderHandler<Args...>
+  MockApiServer::profiled(const QString& route, Handler<Args...> handler) {
+    auto profile = m_routeProfiles.find(route);
+    const RouteProfile* routeProfile =
+        profile == m_routeProfiles.end() ? nullptr : &profile->second;
+    auto* routeMetrics = &m_metrics->route(route);
+    auto* accessLog = m_accessLog.get();
+
+    return [this,
+            handler = std::move(handler),
+            routeProfile,
+            routeMetrics,
+            accessLog](Args... args,
+                       const QHttpServerRequest& request,
+                       QHttpServerResponder&& responder) {
+      auto startedAt = std::chrono::steady_clock::now();
+      Outcome outcome;
+      if (nullptr != routeProfile) {
+        outcome = decide(*routeProfile, startedAt - m_startedAt);
+      }
+      auto state = outcome.fault.value_or(m_state);
+      auto response = handler(args..., request, state);
+
+      AccessLog::Record record{ .route = &routeMetrics->name(),
+                                .state = state,
+                                .statusCode = statusCodeOf(response) };
+      if (nullptr != accessLog) {
+        record.role = resolveRole(request);
+        record.bytesIn = request.body().size();
+        record.bytesOut = response.data().size();
+      }
+
+      // Timer is bound to connection, so it is dropped if client goes away
+      auto* socket = LimitingTcpServer::connectionOf(request);
+      if (outcome.delay.count() > 0 and nullptr == socket) {
+        // Responder must not outlive connection it can't be bound to
+        routeMetrics->recordSkippedDelay();
+        static std::atomic_flag warned;
+        if (not warned.test_and_set()) {
+          qWarning() << "API Mock sent response of" << routeMetrics->name()
+                     << "without its delay, its connection was not found";
         }
-      ],
-      "customer": {
-        "id": "5f3bc9e2502422053e08f9f1",
-        "code": "bge"
-      },
-      "metadata": {
-        "created": "2020-10-13T21:31:51.259Z", 
-        "modified": "2020-10-13T21:31:51.259Z", 
-        "user": { 
-          "id": "5f3bc9e2502422053e08f9f1", 
-          "username": "test@reelsense.io" 
-        } 
       }
-    })";
-} // namespace
+      if (outcome.delay.count() <= 0 or nullptr == socket) {
+        account(*routeMetrics, accessLog, record, startedAt);
+        send(std::move(responder), response);
+        return;
+      }
+      auto delayed = std::make_shared<DelayedResponse>(std::move(responder),
+                                                       std::move(response));
+      QTimer::singleShot(
+          std::chrono::ceil<std::chrono::milliseconds>(outcome.delay),
+          Qt::PreciseTimer,
+          socket,
+          [delayed, routeMetrics, accessLog, record, startedAt] {
+            account(*routeMetrics, accessLog, record, startedAt);
+            send(std::move(delayed->responder), delayed->response);
+          });
+    };
+  }
 
-namespace test::api {
-  MockApiServer::MockApiServer(State state) {
-    m_server.route(
+  void MockApiServer::registerRoutes(QHttpServer& server) {
+    server.route("/metrics",
+                 QHttpServerRequest::Method::Get,
+                 [this]() -> QHttpServerResponse {
+                   auto text = m_metrics->exposition();
+                   if (m_accessLog) {
+                     text += m_accessLog->exposition();
+                   }
+                   return QHttpServerResponse(
+                       "text/plain; version=0.0.4; charset=utf-8",
+                       std::move(text));
+                 });
+
+    server.route(
         "/login/<arg>",
         QHttpServerRequest::Method::Get,
-        [](const QString& id) -> QHttpServerResponse {
-          try {
-
-            const auto& userToken = users.at(id);
-            QJsonObject responseBody;
-            responseBody["jwtToken"] = userToken;
-            return responseBody;
-
-          } catch (const std::out_of_range& idError) {
-            return QHttpServerResponse::StatusCode::InternalServerError;
-          }
-        });
-
-    m_server.route(
+        profiled<const QString&>(
+            "GET /login/<arg>",
+            [](const QString& id,
+               const QHttpServerRequest&,
+               State) -> QHttpServerResponse {
+              try {
+
+                const auto& userToken = tokenOf(id);
+                QJsonObject responseBody;
+                responseBody["jwtToken"] = userToken;
+                return responseBody;
+
+              } catch (const std::out_of_range& idError) {
+                return QHttpServerResponse::StatusCode::InternalServerError;
+              }
+            }));
+
+    server.route(
+        "/cable/type",
+        QHttpServerRequest::Method::Post,
+        profiled<>(
+            "POST /cable/type",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, adminsOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              QJsonObject cableType =
+                  QJsonDocument::fromJson(request.body()).object();
+              if (auto error = createCableType(cableType)) {
+                return makeResponse(*error);
+              }
+
+              return cableType;
+            }));
+
+    server.route(
         "/cable/type",
+        QHttpServerRequest::Method::Get,
+        profiled<>(
+            "GET /cable/type",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              const auto query = request.query();
+              const auto customerCode = query.queryItemValue("customer.code");
+
+              const auto pageSize = pageLimitOf(query, defaultPageSize);
+              if (const auto* error = std::get_if<Error>(&pageSize)) {
+                return makeResponse(*error);
+              }
+
+              QString afterId;
+              if (query.hasQueryItem("cursor")) {
+                auto cursorAfterId =
+                    afterIdOf(query.queryItemValue("cursor"), customerCode);
+                if (not cursorAfterId) {
+                  return makeResponse(Error::InvalidCursor);
+                }
+                afterId = *cursorAfterId;
+              }
+
+              auto page = m_store.list(
+                  customerCode, afterId, std::get<qsizetype>(pageSize));
+
+              // Cable types are serialized on write, page is only joined
+              static const QByteArray mimeType{ "application/json" };
+              QByteArray body = R"({"cableTypes":[)";
+              for (const auto& cableType : page.cableTypes) {
+                if (&cableType != &page.cableTypes.front()) {
+                  body += ',';
+                }
+                body += cableType->json();
+              }
+              body += ']';
+              if (not page.nextAfterId.isEmpty()) {
+                body += R"(,"nextCursor":")" +
+                        makeCursor(customerCode, page.nextAfterId).toLatin1() +
+                        '"';
+              }
+              body += '}';
+
+              return QHttpServerResponse(
+                  mimeType, body, QHttpServerResponse::StatusCode::Ok);
+            }));
+
+    server.route(
+        "/cable/type/range",
+        QHttpServerRequest::Method::Get,
+        profiled<>(
+            "GET /cable/type/range",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              const auto query = request.query();
+              const auto customerCode = query.queryItemValue("customer.code");
+              const auto selected = selectionQueryOf(query);
+              if (const auto* error = std::get_if<Error>(&selected)) {
+                return makeResponse(*error);
+              }
+              const auto [limit, documents] = std::get<Selection>(selected);
+
+              auto predicates = rangePredicatesOf(
+                  query, { "customer.code", "select", "limit" });
+              if (not predicates) {
+                return makeResponse(Error::InvalidRangeQuery);
+              }
+
+              auto result = queryRanges(
+                  m_store, *predicates, customerCode, limit, documents);
+              m_metrics->recordScan(result.scannedRows, result.scanTime);
+
+              // Documents are serialized on write, ids and summary are small
+              static const QByteArray mimeType{ "application/json" };
+              auto body = '{' +
+                          selectionOf(result.ids,
+                                      result.cableTypes,
+                                      documents,
+                                      result.matched);
+
+              auto seconds =
+                  std::chrono::duration<double>(result.scanTime).count();
+              QJsonObject scan{
+                { "rows", static_cast<qint64>(result.scannedRows) },
+                { "seconds", seconds },
+                { "rowsPerSecond",
+                  seconds > 0 ? result.scannedRows / seconds : 0.0 },
+                { "kernel", nameOf(result.kernel) }
+              };
+              body += R"(,"scan":)" +
+                      QJsonDocument(scan).toJson(QJsonDocument::Compact) + '}';
+
+              return QHttpServerResponse(
+                  mimeType, body, QHttpServerResponse::StatusCode::Ok);
+            }));
+
+    server.route(
+        "/cable/type/stats",
+        QHttpServerRequest::Method::Get,
+        profiled<>(
+            "GET /cable/type/stats",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              // Aggregates are kept by store, only groups are serialized
+              auto statistics = m_store.statistics();
+              return QJsonObject{
+                { "customers", toJson(statistics.customers, "code") },
+                { "manufacturers", toJson(statistics.manufacturers, "id") }
+              };
+            }));
+
+    server.route(
+        "/cable/type/manufacturer/id/<arg>",
+        QHttpServerRequest::Method::Get,
+        profiled<const QString&>(
+            "GET /cable/type/manufacturer/id/<arg>",
+            [this](const QString& manufacturerId,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              const auto query = request.query();
+              const auto selected = selectionQueryOf(query);
+              if (const auto* error = std::get_if<Error>(&selected)) {
+                return makeResponse(*error);
+              }
+              const auto [limit, documents] = std::get<Selection>(selected);
+
+              auto matches = m_store.findByManufacturerId(
+                  manufacturerId, limit, documents);
+
+              static const QByteArray mimeType{ "application/json" };
+              auto body = '{' +
+                          selectionOf(matches.ids,
+                                      matches.cableTypes,
+                                      documents,
+                                      matches.matched) +
+                          '}';
+              return QHttpServerResponse(
+                  mimeType, body, QHttpServerResponse::StatusCode::Ok);
+            }));
+
+    server.route(
+        "/cable/type/property/name/<arg>",
+        QHttpServerRequest::Method::Get,
+        profiled<const QString&>(
+            "GET /cable/type/property/name/<arg>",
+            [this](const QString& name,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              const auto query = request.query();
+              const auto selected = selectionQueryOf(query);
+              if (const auto* error = std::get_if<Error>(&selected)) {
+                return makeResponse(*error);
+              }
+              const auto [limit, documents] = std::get<Selection>(selected);
+
+              auto matches =
+                  m_store.findByPropertyName(name, limit, documents);
+
+              static const QByteArray mimeType{ "application/json" };
+              auto body = '{' +
+                          selectionOf(matches.ids,
+                                      matches.cableTypes,
+                                      documents,
+                                      matches.matched) +
+                          '}';
+              return QHttpServerResponse(
+                  mimeType, body, QHttpServerResponse::StatusCode::Ok);
+            }));
+
+    server.route(
+        "/cable/type/bulk",
         QHttpServerRequest::Method::Post,
-        [state](const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token != users.at("superuser") and token != users.at("admin")) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject requestBody =
-              QJsonDocument::fromJson(request.body()).object();
-
-          if (requestBody.contains("id")) {
-            return makeResponse(R"({"cause": "id provided in request"})",
-                                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (not requestBody.contains("catid") or
-              not requestBody.contains("identifier")) {
-            return makeResponse(R"({"cause": "missing required keys"})",
-                                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (requestBody.contains("rotationFrequency") and
-              (not requestBody["rotationFrequency"].isObject() or
-               not requestBody["rotationFrequency"].toObject().contains(
-                   "unit"))) {
-            return makeResponse(
-                R"({"cause": "rotationFrequency invalid specification"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (requestBody.contains("rotationFrequency") and
-              validateRotationFrequencyUnitValues(
-                  requestBody["rotationFrequency"]
-                      .toObject()["unit"]
-                      .toString())) {
-            return makeResponse(
-                R"({"cause": "rotationFrequency.unit has invalid value"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          const auto metadataRawJson = QString(
-              R"({ 
-                  "created": "2020-10-13T21:31:51.259Z", 
-                  "modified": "2020-10-13T21:31:51.259Z", 
-                  "user": { 
-                    "id": "5f3bc9e2502422053e08f9f1", 
-                    "username": "test@reelsense.io" 
-                  } 
-                })");
-
-          QJsonObject metadataGenerated =
-              QJsonDocument::fromJson(metadataRawJson.toUtf8()).object();
-          QJsonObject responseBody = requestBody;
-          responseBody["metadata"] = metadataGenerated;
-          responseBody["id"] = "5f3bc9e2502422053e08f9f1";
-
-          return responseBody;
-        });
-
-    m_server.route(
+        profiled<>(
+            "POST /cable/type/bulk",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, adminsOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              static const QByteArray mimeType{ "application/x-ndjson" };
+              const auto body = request.body();
+
+              QByteArray results;
+              qint64 lineNumber = 0;
+              for (qsizetype begin = 0; begin < body.size(); ++lineNumber) {
+                auto end = body.indexOf('\n', begin);
+                if (end < 0) {
+                  end = body.size();
+                }
+                auto length = end - begin;
+                if (length > 0 and '\r' == body[end - 1]) {
+                  --length;
+                }
+                auto line = QByteArray::fromRawData(body.constData() + begin,
+                                                    length);
+                begin = end + 1;
+                if (line.isEmpty()) {
+                  continue;
+                }
+
+                QJsonObject result{
+                  { "line", lineNumber + 1 }
+                };
+                QJsonParseError parseError;
+                auto document = QJsonDocument::fromJson(line, &parseError);
+                if (QJsonParseError::NoError != parseError.error or
+                    not document.isObject()) {
+                  result["cause"] = causeOf(Error::InvalidJsonObject);
+                } else {
+                  auto cableType = document.object();
+                  if (auto error = createCableType(cableType)) {
+                    result["cause"] = causeOf(*error);
+                  } else {
+                    result["id"] = cableType.value("id");
+                  }
+                }
+                results += QJsonDocument(result).toJson(QJsonDocument::Compact);
+                results += '\n';
+              }
+
+              return QHttpServerResponse(
+                  mimeType, results, QHttpServerResponse::StatusCode::Ok);
+            }));
+
+    server.route(
         "/cable/type/id/<arg>",
         QHttpServerRequest::Method::Get,
-        [state](const QString& id,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty()) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          auto response =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          auto idSize = id.size();
-          auto correctIdSize = response["id"].toString().size();
-          if (idSize < correctIdSize or idSize > correctIdSize) {
-            return makeResponse(
-                R"({"cause": "Cable type id has invalid format"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (id != response["id"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type doesn't exists by specified id"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return response;
-        });
-
-    m_server.route(
+        profiled<const QString&>(
+            "GET /cable/type/id/<arg>",
+            [this](const QString& id,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, anyToken)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              if (id.size() != CableTypeStore::idLength) {
+                return makeResponse(Error::InvalidIdFormat);
+              }
+
+              auto cableType = m_store.findById(id);
+              if (not cableType) {
+                return makeResponse(Error::NotFoundById);
+              }
+
+              return makeResponse(request, *cableType);
+            }));
+
+    server.route(
         "/cable/type/id/<arg>",
         QHttpServerRequest::Method::Delete,
-        [state](const QString& id,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty() or
-              (token != users.at("superuser") and token != users.at("admin"))) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::CableTypeReferencedByOtherEntities == state) {
-            return makeResponse(
-                R"({"cause": "Cable type is referenced by other entities"})",
-                QHttpServerResponse::StatusCode::PreconditionFailed);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          auto response =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          auto idSize = id.size();
-          auto correctIdSize = response["id"].toString().size();
-          if (idSize < correctIdSize or idSize > correctIdSize) {
-            return makeResponse(
-                R"({"cause": "Cable type id has invalid format"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (id != response["id"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type doesn't exists by specified id"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return QJsonDocument::fromJson("{}").object();
-        });
-
-    m_server.route(
+        profiled<const QString&>(
+            "DELETE /cable/type/id/<arg>",
+            [this](const QString& id,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, adminsOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::CableTypeReferencedByOtherEntities == state) {
+                return makeResponse(Error::CableTypeReferencedByOtherEntities);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              if (id.size() != CableTypeStore::idLength) {
+                return makeResponse(Error::InvalidIdFormat);
+              }
+
+              if (not m_store.remove(id)) {
+                return makeResponse(Error::NotFoundById);
+              }
+
+              return QJsonObject();
+            }));
+
+    server.route(
         "/cable/type/id/<arg>",
         QHttpServerRequest::Method::Put,
-        [state](const QString& id,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token != users.at("superuser") and token != users.at("admin")) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject requestBody =
-              QJsonDocument::fromJson(request.body()).object();
-
-          if (not requestBody.contains("id")) {
-            return makeResponse(R"({"cause": "id not provided in request"})",
-                                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (id != requestBody["id"].toString()) {
-            return makeResponse(
-                R"({"cause": "id mismatch for URL and request body"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (not requestBody.contains("catid") or
-              not requestBody.contains("identifier")) {
-            return makeResponse(R"({"cause": "missing required keys"})",
-                                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          QJsonObject defaultCableType =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          if (defaultCableType["id"] != requestBody["id"] or
-              defaultCableType["catid"] != requestBody["catid"] or
-              defaultCableType["identifier"] != requestBody["identifier"]) {
-            return makeResponse(
-                R"({"cause": "Attempt to change immutable keys"})",
-                QHttpServerResponse::StatusCode::PreconditionFailed);
-          }
-
-          if (requestBody.contains("rotationFrequency") and
-              (not requestBody["rotationFrequency"].isObject() or
-               not requestBody["rotationFrequency"].toObject().contains(
-                   "unit"))) {
-            return makeResponse(
-                R"({"cause": "rotationFrequency invalid specification"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          if (requestBody.contains("rotationFrequency") and
-              validateRotationFrequencyUnitValues(
-                  requestBody["rotationFrequency"]
-                      .toObject()["unit"]
-                      .toString())) {
-            return makeResponse(
-                R"({"cause": "rotationFrequency.unit has invalid value"})",
-                QHttpServerResponse::StatusCode::BadRequest);
-          }
-
-          return requestBody;
-        });
-
-    m_server.route(
+        profiled<const QString&>(
+            "PUT /cable/type/id/<arg>",
+            [this](const QString& id,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, adminsOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              QJsonObject requestBody =
+                  QJsonDocument::fromJson(request.body()).object();
+
+              if (not requestBody.contains("id")) {
+                return makeResponse(Error::IdNotProvidedInRequest);
+              }
+
+              if (id != requestBody["id"].toString()) {
+                return makeResponse(Error::IdMismatch);
+              }
+
+              if (not requestBody.contains("catid") or
+                  not requestBody.contains("identifier")) {
+                return makeResponse(Error::MissingRequiredKeys);
+              }
+
+              auto storedCableType = m_store.findById(id);
+              if (not storedCableType) {
+                return makeResponse(Error::NotFoundById);
+              }
+
+              const auto& stored = storedCableType->cableType();
+              if (stored["catid"] != requestBody["catid"] or
+                  stored["identifier"] != requestBody["identifier"]) {
+                return makeResponse(Error::ImmutableKeysChange);
+              }
+
+              if (auto error = validateRotationFrequency(requestBody)) {
+                return makeResponse(*error);
+              }
+
+              m_store.replace(id, requestBody);
+              return requestBody;
+            }));
+
+    server.route(
         "/cable/type/identifier/<arg>",
         QHttpServerRequest::Method::Get,
-        [state](const QString& identifier,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty()) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject defaultCableType =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          if (identifier != defaultCableType["identifier"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type not found by identifier"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return defaultCableType;
-        });
-
-    m_server.route(
+        profiled<const QString&>(
+            "GET /cable/type/identifier/<arg>",
+            [this](const QString& identifier,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, anyToken)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              auto cableType = m_store.findByIdentifier(identifier);
+              if (not cableType) {
+                return makeResponse(Error::NotFoundByIdentifier);
+              }
+
+              return makeResponse(request, *cableType);
+            }));
+
+    server.route(
+        "/cable/type/autocomplete",
+        QHttpServerRequest::Method::Get,
+        profiled<>(
+            "GET /cable/type/autocomplete",
+            [this](const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, anyToken)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              const auto query = request.query();
+              const auto limit = pageLimitOf(query, defaultCompletions);
+              if (const auto* error = std::get_if<Error>(&limit)) {
+                return makeResponse(*error);
+              }
+
+              auto identifiers = m_store.completeIdentifier(
+                  query.queryItemValue("prefix", QUrl::FullyDecoded),
+                  std::get<qsizetype>(limit),
+                  "true" == query.queryItemValue("typos"));
+              return QJsonObject{
+                { "identifiers",
+                  QJsonArray::fromStringList(
+                      QStringList(identifiers.begin(), identifiers.end())) }
+              };
+            }));
+
+    server.route(
         "/cable/type/catid/<arg>",
         QHttpServerRequest::Method::Get,
-        [state](int catid,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty()) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject defaultCableType =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          if (catid != defaultCableType["catid"].toInt()) {
-            return makeResponse(R"({"cause": "Cable type not found by catid"})",
-                                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return defaultCableType;
-        });
-
-    m_server.route(
+        profiled<int>(
+            "GET /cable/type/catid/<arg>",
+            [this](int catid,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, anyToken)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              auto cableType = m_store.findByCatId(catid);
+              if (not cableType) {
+                return makeResponse(Error::NotFoundByCatId);
+              }
+
+              return makeResponse(request, *cableType);
+            }));
+
+    server.route(
         "/cable/type/identifier/<arg>/customer/code/<arg>",
         QHttpServerRequest::Method::Get,
-        [state](const QString& identifier,
-                const QString& code,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty() or token != users.at("superuser")) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject defaultCableType =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          if (identifier != defaultCableType["identifier"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type not found by identifier"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          if (code !=
-              defaultCableType["customer"].toObject()["code"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type not found by customer code"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return defaultCableType;
-        });
-
-    m_server.route(
+        profiled<const QString&, const QString&>(
+            "GET /cable/type/identifier/<arg>/customer/code/<arg>",
+            [this](const QString& identifier,
+                   const QString& code,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              auto cableType =
+                  m_store.findByIdentifierAndCustomerCode(identifier, code);
+              if (cableType) {
+                return makeResponse(request, *cableType);
+              }
+
+              if (not m_store.findByIdentifier(identifier)) {
+                return makeResponse(Error::NotFoundByIdentifier);
+              }
+
+              return makeResponse(Error::NotFoundByCustomerCode);
+            }));
+
+    server.route(
         "/cable/type/catid/<arg>/customer/code/<arg>",
         QHttpServerRequest::Method::Get,
-        [state](int catid,
-                const QString& code,
-                const QHttpServerRequest& request) -> QHttpServerResponse {
-          auto token = extractUserTokenFromHeaders(request.headers());
-          if (token.isEmpty() or token != users.at("superuser")) {
-            return responseByState(State::Unauthorized);
-          }
-
-          if (State::Normal != state) {
-            return responseByState(state);
-          }
-
-          QJsonObject defaultCableType =
-              QJsonDocument::fromJson(defaultCableTypeData).object();
-
-          if (catid != defaultCableType["catid"].toInt()) {
-            return makeResponse(
-                R"({"cause": "Cable type not found by identifier"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          if (code !=
-              defaultCableType["customer"].toObject()["code"].toString()) {
-            return makeResponse(
-                R"({"cause": "Cable type not found by customer code"})",
-                QHttpServerResponse::StatusCode::NotFound);
-          }
-
-          return defaultCableType;
-        });
-
-    m_server.listen(QHostAddress::LocalHost, 8080);
+        profiled<int, const QString&>(
+            "GET /cable/type/catid/<arg>/customer/code/<arg>",
+            [this](int catid,
+                   const QString& code,
+                   const QHttpServerRequest& request,
+                   State state) -> QHttpServerResponse {
+              if (not isPermitted(request, superuserOnly)) {
+                return responseByState(State::Unauthorized);
+              }
+
+              if (State::Normal != state) {
+                return responseByState(state);
+              }
+
+              auto cableType = m_store.findByCatIdAndCustomerCode(catid, code);
+              if (cableType) {
+                return makeResponse(request, *cableType);
+              }
+
+              if (not m_store.findByCatId(catid)) {
+                return makeResponse(Error::NotFoundByIdentifier);
+              }
+
+              return makeResponse(Error::NotFoundByCustomerCode);
+            }));
   }
-
 } // namespace test::api
@@ -1,11 +1,27 @@
 #pragma once
+#include "CableTypeStore.h"
+#include "Latency.h"
+#include "WorkerPool.h"
+
 #include <QHttpServer>
 #include <QHttpServerRequest>
+#include <QHttpServerResponder>
 #include <QHttpServerResponse>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QUrl>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
 
 namespace test::api {
+  enum class Error;
+  class Metrics;
+  class AccessLog;
+
   class MockApiServer {
 
   public:
@@ -24,10 +40,174 @@ namespace test::api {
       CableTypeReferencedByOtherEntities
     };
 
+    /*
+     * Failure injected into requests to route.
+     */
+    struct Fault {
+      /*
+       * Route responds as API Mock in this state would.
+       */
+      State state = State::Normal;
+      double probability = 0.0;
+
+      /*
+       * Latency of failed request, route latency is used if not set.
+       */
+      latency::Distribution latency;
+    };
+
+    /*
+     * Window repeating every period, e.g. 2 s out of each minute,
+     * during which its faults and latency replace ones of route.
+     */
+    struct Burst {
+      std::chrono::milliseconds period{ 0 };
+      std::chrono::milliseconds length{ 0 };
+      std::vector<Fault> faults;
+      latency::Distribution latency;
+    };
+
+    /*
+     * Latency and faults of route, faults are tried in order.
+     * Responses are delayed with timers, other connections are not stalled.
+     */
+    struct RouteProfile {
+      latency::Distribution latency;
+      std::vector<Fault> faults;
+      std::optional<Burst> burst;
+    };
+
+    struct Options {
+      /*
+       * Port to listen on, 0 lets system pick free one.
+       */
+      quint16 port = 0;
+
+      /*
+       * Number of threads serving requests,
+       * 0 serves them on thread owning API Mock.
+       */
+      std::size_t workerThreads = 0;
+
+      /*
+       * Largest request body accepted, larger ones are rejected with 413
+       * before they are buffered. 0 disables the limit.
+       */
+      qint64 maxBodySize = 1024 * 1024;
+
+      /*
+       * Largest body accepted by bulk routes, 0 disables the limit.
+       * Bulk body is buffered whole by HTTP server before it is parsed,
+       * so the limit is memory a bulk request can take. Default fits
+       * 100 000 cable types of about 1 KiB each with room to spare.
+       */
+      qint64 maxBufferedBulkBodySize = 256 * 1024 * 1024;
+
+      /*
+       * Profiles of routes, keyed by method and route,
+       * e.g. "GET /cable/type/id/<arg>". Routes without one respond
+       * immediately according to API Mock state.
+       */
+      std::unordered_map<QString, RouteProfile> routeProfiles;
+
+      /*
+       * File to append access log to, one JSON object per request.
+       * Empty disables access log.
+       */
+      QString accessLogPath;
+
+      /*
+       * Records buffered for access log file,
+       * records not fitting are dropped and counted at /metrics.
+       */
+      std::size_t accessLogCapacity = 64 * 1024;
+
+      /*
+       * Newline delimited JSON file of cable types (with ids)
+       * stored before API Mock starts listening, parsed on all cores.
+       */
+      QString seedPath;
+
+      /*
+       * Snapshot of store (see saveSnapshot()) loaded before seeding,
+       * mapped instead of parsed, so API Mock starts fast.
+       */
+      QString snapshotPath;
+    };
+
+    /*
+     * Page size of cable type list if not requested explicitly,
+     * larger pages requested are capped.
+     */
+    static constexpr qsizetype defaultPageSize = 50;
+    static constexpr qsizetype maxPageSize = 500;
+
+    /*
+     * Count of completed identifiers if not requested explicitly,
+     * larger counts requested are capped by page size.
+     */
+    static constexpr qsizetype defaultCompletions = 10;
+
     MockApiServer(State state = State::Normal);
-    ~MockApiServer() = default;
+    MockApiServer(State state, Options options);
+    ~MockApiServer();
+
+    CableTypeStore& store() noexcept;
+    quint16 port() const noexcept;
+
+    /*
+     * Requests served so far, also exposed at /metrics.
+     */
+    const Metrics& metrics() const noexcept;
+
+    /*
+     * URL of API Mock endpoint, e.g. url("/cable/type").
+     * Without path gives base URL of API Mock.
+     */
+    QUrl url(const QString& path = {}) const;
 
   private:
+    void registerRoutes(QHttpServer& server);
+
+    /*
+     * Validates and stores cable type sent to be created,
+     * completing it with metadata and id on success.
+     * Stored cable type of the same identifier and customer code
+     * is replaced and its id is kept (see CableTypeStore::create),
+     * conflict is never answered by store content, only by state.
+     */
+    std::optional<Error> createCableType(QJsonObject& cableType);
+
+    /*
+     * Route handler, given state to respond in for this request.
+     */
+    template <typename... Args>
+    using Handler = std::function<QHttpServerResponse(
+        Args..., const QHttpServerRequest&, State)>;
+
+    template <typename... Args>
+    using ResponderHandler = std::function<void(
+        Args..., const QHttpServerRequest&, QHttpServerResponder&&)>;
+
+    /*
+     * Applies profile of route, if any, to responses of handler:
+     * picks fault replacing state and delays response.
+     * Every response is counted in metrics of route and access log.
+     */
+    template <typename... Args>
+    ResponderHandler<Args...> profiled(const QString& route,
+                                       Handler<Args...> handler);
+
+    // Used by route handlers, so declared before servers running them
+    CableTypeStore m_store;
+    State m_state;
+    std::unordered_map<QString, RouteProfile> m_routeProfiles;
+    std::chrono::steady_clock::time_point m_startedAt;
+    std::unique_ptr<Metrics> m_metrics;
+    std::unique_ptr<AccessLog> m_accessLog;
+
     QHttpServer m_server;
+    std::unique_ptr<WorkerPool> m_workerPool;
+    quint16 m_port = 0;
   };
 } // namespace test::api
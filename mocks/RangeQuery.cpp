@@ -0,0 +1,221 @@
+#include "RangeQuery.h"
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define API_MOCK_X86_KERNELS
+#endif
+
+namespace {
+  using test::api::ScanKernel;
+
+  static constexpr std::size_t wordBits = 64;
+
+  void scanScalar(const double* values,
+                  std::size_t size,
+                  double min,
+                  double max,
+                  quint64* matches) noexcept {
+    for (std::size_t word = 0; word * wordBits < size; ++word) {
+      if (0 == matches[word]) {
+        continue;
+      }
+      const auto* block = values + word * wordBits;
+      auto count = std::min(wordBits, size - word * wordBits);
+      quint64 mask = 0;
+      for (std::size_t bit = 0; bit < count; ++bit) {
+        // Comparisons with NaN are false, so missing values never match
+        mask |= quint64{ block[bit] >= min and block[bit] <= max } << bit;
+      }
+      matches[word] &= mask;
+    }
+  }
+
+#ifdef API_MOCK_X86_KERNELS
+  /*
+   * Vector kernels scan whole words only, scalar one scans the rest.
+   */
+  __attribute__((target("sse2"))) void scanSse2(const double* values,
+                                                std::size_t words,
+                                                double min,
+                                                double max,
+                                                quint64* matches) noexcept {
+    auto low = _mm_set1_pd(min);
+    auto high = _mm_set1_pd(max);
+    for (std::size_t word = 0; word < words; ++word) {
+      if (0 == matches[word]) {
+        continue;
+      }
+      const auto* block = values + word * wordBits;
+      quint64 mask = 0;
+      for (std::size_t lane = 0; lane < wordBits; lane += 2) {
+        auto value = _mm_loadu_pd(block + lane);
+        auto within = _mm_and_pd(_mm_cmpge_pd(value, low),
+                                 _mm_cmple_pd(value, high));
+        mask |= static_cast<quint64>(_mm_movemask_pd(within)) << lane;
+      }
+      matches[word] &= mask;
+    }
+  }
+
+  __attribute__((target("avx2"))) void scanAvx2(const double* values,
+                                                std::size_t words,
+                                                double min,
+                                                double max,
+                                                quint64* matches) noexcept {
+    auto low = _mm256_set1_pd(min);
+    auto high = _mm256_set1_pd(max);
+    for (std::size_t word = 0; word < words; ++word) {
+      if (0 == matches[word]) {
+        continue;
+      }
+      const auto* block = values + word * wordBits;
+      quint64 mask = 0;
+      for (std::size_t lane = 0; lane < wordBits; lane += 4) {
+        auto value = _mm256_loadu_pd(block + lane);
+        auto within = _mm256_and_pd(_mm256_cmp_pd(value, low, _CMP_GE_OQ),
+                                    _mm256_cmp_pd(value, high, _CMP_LE_OQ));
+        mask |= static_cast<quint64>(_mm256_movemask_pd(within)) << lane;
+      }
+      matches[word] &= mask;
+    }
+  }
+#endif
+
+  void scanEqual(std::span<const test::api::StringPool::Id> ids,
+                 test::api::StringPool::Id id,
+                 std::span<quint64> matches) noexcept {
+    for (std::size_t word = 0; word * wordBits < ids.size(); ++word) {
+      if (0 == matches[word]) {
+        continue;
+      }
+      auto count = std::min(wordBits, ids.size() - word * wordBits);
+      quint64 mask = 0;
+      for (std::size_t bit = 0; bit < count; ++bit) {
+        mask |= quint64{ ids[word * wordBits + bit] == id } << bit;
+      }
+      matches[word] &= mask;
+    }
+  }
+} // namespace
+
+namespace test::api {
+  bool isSupported(ScanKernel kernel) noexcept {
+    switch (kernel) {
+    case ScanKernel::Scalar:
+      return true;
+#ifdef API_MOCK_X86_KERNELS
+    case ScanKernel::Sse2:
+      return __builtin_cpu_supports("sse2");
+    case ScanKernel::Avx2:
+      return __builtin_cpu_supports("avx2");
+#else
+    case ScanKernel::Sse2:
+    case ScanKernel::Avx2:
+      return false;
+#endif
+    }
+    return false;
+  }
+
+  ScanKernel bestScanKernel() noexcept {
+    static const auto best = [] {
+      for (auto kernel : { ScanKernel::Avx2, ScanKernel::Sse2 }) {
+        if (isSupported(kernel)) {
+          return kernel;
+        }
+      }
+      return ScanKernel::Scalar;
+    }();
+    return best;
+  }
+
+  const char* nameOf(ScanKernel kernel) noexcept {
+    switch (kernel) {
+    case ScanKernel::Scalar:
+      return "scalar";
+    case ScanKernel::Sse2:
+      return "sse2";
+    case ScanKernel::Avx2:
+      return "avx2";
+    }
+    return "unknown";
+  }
+
+  void scanRange(ScanKernel kernel,
+                 std::span<const double> values,
+                 double min,
+                 double max,
+                 std::span<quint64> matches) noexcept {
+    std::size_t words = 0;
+#ifdef API_MOCK_X86_KERNELS
+    words = values.size() / wordBits;
+    if (ScanKernel::Avx2 == kernel) {
+      scanAvx2(values.data(), words, min, max, matches.data());
+    } else if (ScanKernel::Sse2 == kernel) {
+      scanSse2(values.data(), words, min, max, matches.data());
+    } else {
+      words = 0;
+    }
+#else
+    static_cast<void>(kernel);
+#endif
+    scanScalar(values.data() + words * wordBits,
+               values.size() - words * wordBits,
+               min,
+               max,
+               matches.data() + words);
+  }
+
+  RangeQueryResult queryRanges(const CableTypeStore& store,
+                               std::span<const RangePredicate> predicates,
+                               const QString& customerCode,
+                               std::size_t limit,
+                               bool documents) {
+    RangeQueryResult result;
+    result.kernel = bestScanKernel();
+    store.scan([&](const CableTypeColumns& columns,
+                   std::span<const CableTypeStore::Entry> entries) {
+      auto rows = columns.size();
+      std::vector<quint64> matches((rows + wordBits - 1) / wordBits,
+                                   ~quint64{ 0 });
+      if (0 != rows % wordBits) {
+        matches.back() = (quint64{ 1 } << (rows % wordBits)) - 1;
+      }
+
+      auto startedAt = std::chrono::steady_clock::now();
+      for (const auto& predicate : predicates) {
+        scanRange(result.kernel,
+                  columns.values(predicate.field),
+                  predicate.min,
+                  predicate.max,
+                  matches);
+      }
+      if (not customerCode.isEmpty()) {
+        auto code = columns.strings().find(customerCode);
+        if (code) {
+          scanEqual(columns.customerCodes(), *code, matches);
+        } else {
+          std::fill(matches.begin(), matches.end(), 0);
+        }
+      }
+      result.scanTime = std::chrono::steady_clock::now() - startedAt;
+      result.scannedRows = rows;
+
+      for (std::size_t word = 0; word < matches.size(); ++word) {
+        auto bits = matches[word];
+        result.matched += std::popcount(bits);
+        for (; 0 != bits and result.ids.size() < limit; bits &= bits - 1) {
+          auto row = word * wordBits + std::countr_zero(bits);
+          result.ids.push_back(columns.id(row));
+          if (documents) {
+            result.cableTypes.push_back(entries[row]);
+          }
+        }
+      }
+    });
+    return result;
+  }
+} // namespace test::api
@@ -0,0 +1,74 @@
+#pragma once
+#include "CableTypeStore.h"
+
+#include <QString>
+#include <chrono>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Inclusive bounds on numeric field, open bound is infinite.
+   * Cable types without the field never match.
+   */
+  struct RangePredicate {
+    NumericField field = NumericField::CurrentPrice;
+    double min = -std::numeric_limits<double>::infinity();
+    double max = std::numeric_limits<double>::infinity();
+  };
+
+  /*
+   * Instruction sets column scans are implemented with.
+   */
+  enum class ScanKernel { Scalar, Sse2, Avx2 };
+
+  bool isSupported(ScanKernel kernel) noexcept;
+
+  /*
+   * Widest kernel CPU supports, picked once at runtime.
+   */
+  ScanKernel bestScanKernel() noexcept;
+
+  const char* nameOf(ScanKernel kernel) noexcept;
+
+  /*
+   * Clears bit of each row in matches (64 rows per word, row 0 is lowest bit
+   * of first word) whose value is out of [min, max] or NaN,
+   * so predicates are combined by scanning each into the same bitmap.
+   * Matches must have room for all values, kernel must be supported.
+   */
+  void scanRange(ScanKernel kernel,
+                 std::span<const double> values,
+                 double min,
+                 double max,
+                 std::span<quint64> matches) noexcept;
+
+  struct RangeQueryResult {
+    /*
+     * Matching cable types in row order, up to limit.
+     */
+    std::vector<QString> ids;
+    std::vector<CableTypeStore::Entry> cableTypes;
+
+    /*
+     * All matching cable types, regardless of limit.
+     */
+    std::size_t matched = 0;
+
+    std::size_t scannedRows = 0;
+    std::chrono::nanoseconds scanTime{ 0 };
+    ScanKernel kernel = ScanKernel::Scalar;
+  };
+
+  /*
+   * Cable types matching all predicates (and customer code, unless empty),
+   * scanned over store columns with best kernel.
+   * Documents are collected only if asked, ids always are.
+   */
+  RangeQueryResult queryRanges(const CableTypeStore& store,
+                               std::span<const RangePredicate> predicates,
+                               const QString& customerCode,
+                               std::size_t limit,
+                               bool documents);
+} // namespace test::api
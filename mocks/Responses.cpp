@@ -0,0 +1,288 @@
+#include "Responses.h"
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <array>
+
+namespace {
+  using test::api::Error;
+
+  struct ErrorDefinition {
+    Error error;
+    const char* cause;
+    QHttpServerResponse::StatusCode statusCode;
+  };
+
+  using StatusCode = QHttpServerResponse::StatusCode;
+
+  /*
+   * Order must follow State enumeration.
+   */
+  static constexpr const char* stateNames[] = {
+    "Normal",
+    "Unauthorized",
+    "AttemptToAccessAnotherCustomerData",
+    "NonExistingCustomerId",
+    "CableTypeAlreadyExists",
+    "BusinessRulesViolated",
+    "DatabaseRejectedTransaction",
+    "DatabaseUnhandledError",
+    "DatabaseRequestTimeout",
+    "DatabaseConnectionError",
+    "TooLargePayload",
+    "CableTypeReferencedByOtherEntities",
+  };
+  static_assert(
+      std::size(stateNames) ==
+      static_cast<std::size_t>(
+          test::api::MockApiServer::State::CableTypeReferencedByOtherEntities) +
+          1);
+
+  /*
+   * Every error response API Mock is able to send.
+   * Order must follow Error enumeration, so error is an index in this table.
+   */
+  static constexpr std::array errorDefinitions = {
+    ErrorDefinition{ Error::Unauthorized,
+                     "Unauthorized",
+                     StatusCode::Unauthorized },
+    ErrorDefinition{ Error::AttemptToAccessAnotherCustomerData,
+                     "Attempt to access another customer data",
+                     StatusCode::Forbidden },
+    ErrorDefinition{ Error::NonExistingCustomerId,
+                     "Non existing customer id specified",
+                     StatusCode::NotFound },
+    ErrorDefinition{ Error::CableTypeAlreadyExists,
+                     "Cable type already exists",
+                     StatusCode::Conflict },
+    ErrorDefinition{ Error::BusinessRulesViolated,
+                     "Business rules violated",
+                     StatusCode::PreconditionFailed },
+    ErrorDefinition{ Error::DatabaseRejectedTransaction,
+                     "Database rejected transaction",
+                     StatusCode::ExpectationFailed },
+    ErrorDefinition{ Error::DatabaseUnhandledError,
+                     "Database unhandled error",
+                     StatusCode::UnprocessableEntity },
+    ErrorDefinition{ Error::DatabaseRequestTimeout,
+                     "Database request timeout",
+                     StatusCode::FailedDependency },
+    ErrorDefinition{ Error::DatabaseConnectionError,
+                     "Database connection error",
+                     StatusCode::InternalServerError },
+    ErrorDefinition{ Error::TooLargePayload,
+                     "Too large payload",
+                     StatusCode::InsufficientStorage },
+    ErrorDefinition{ Error::CableTypeReferencedByOtherEntities,
+                     "Cable type is referenced by other entities",
+                     StatusCode::PreconditionFailed },
+    ErrorDefinition{ Error::IdProvidedInRequest,
+                     "id provided in request",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::IdNotProvidedInRequest,
+                     "id not provided in request",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::IdMismatch,
+                     "id mismatch for URL and request body",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::MissingRequiredKeys,
+                     "missing required keys",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::RotationFrequencyInvalidSpecification,
+                     "rotationFrequency invalid specification",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::RotationFrequencyUnitInvalidValue,
+                     "rotationFrequency.unit has invalid value",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::ImmutableKeysChange,
+                     "Attempt to change immutable keys",
+                     StatusCode::PreconditionFailed },
+    ErrorDefinition{ Error::InvalidIdFormat,
+                     "Cable type id has invalid format",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::NotFoundById,
+                     "Cable type doesn't exists by specified id",
+                     StatusCode::NotFound },
+    ErrorDefinition{ Error::NotFoundByIdentifier,
+                     "Cable type not found by identifier",
+                     StatusCode::NotFound },
+    ErrorDefinition{ Error::NotFoundByCatId,
+                     "Cable type not found by catid",
+                     StatusCode::NotFound },
+    ErrorDefinition{ Error::NotFoundByCustomerCode,
+                     "Cable type not found by customer code",
+                     StatusCode::NotFound },
+    ErrorDefinition{ Error::PayloadExceedsLimit,
+                     "Payload exceeds size limit",
+                     StatusCode::PayloadTooLarge },
+    ErrorDefinition{ Error::InvalidJsonObject,
+                     "invalid JSON object",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::InvalidCursor,
+                     "invalid cursor",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::InvalidPageSize,
+                     "invalid page size",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::InvalidRangeQuery,
+                     "invalid range query",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::InvalidSelection,
+                     "invalid selection",
+                     StatusCode::BadRequest },
+    ErrorDefinition{ Error::UnexpectedError,
+                     "Unexpected error",
+                     StatusCode::BadGateway },
+  };
+
+  static_assert(
+      [] {
+        for (std::size_t i = 0; i < errorDefinitions.size(); ++i) {
+          if (static_cast<std::size_t>(errorDefinitions[i].error) != i) {
+            return false;
+          }
+        }
+        return true;
+      }(),
+      "errorDefinitions order must follow Error enumeration");
+
+  struct PreparedError {
+    QByteArray body;
+    QHttpServerResponse::StatusCode statusCode;
+  };
+
+  /*
+   * Error bodies are serialized once and shared by all responses,
+   * QByteArray is implicitly shared so no body is copied per request.
+   */
+  const std::array<PreparedError, errorDefinitions.size()>& preparedErrors() {
+    static const auto prepared = [] {
+      std::array<PreparedError, errorDefinitions.size()> result{};
+      for (std::size_t i = 0; i < errorDefinitions.size(); ++i) {
+        const auto& definition = errorDefinitions[i];
+        QJsonObject body{
+          { "cause", QString::fromUtf8(definition.cause) }
+        };
+        result[i] = { QJsonDocument(body).toJson(QJsonDocument::Compact),
+                      definition.statusCode };
+      }
+      return result;
+    }();
+    return prepared;
+  }
+} // namespace
+
+namespace test::api {
+  void prepareResponses() {
+    preparedErrors();
+  }
+
+  QHttpServerResponse makeResponse(Error error) {
+    static const QByteArray mimeType{ "application/json" };
+    const auto& [body, statusCode] =
+        preparedErrors()[static_cast<std::size_t>(error)];
+    return QHttpServerResponse(mimeType, body, statusCode);
+  }
+
+  QHttpServerResponse makeResponse(const QHttpServerRequest& request,
+                                   const StoredCableType& cableType) {
+    static const QByteArray mimeType{ "application/json" };
+    auto encoding = negotiateEncoding(request.value("Accept-Encoding"));
+
+    // Client has current cable type already, nothing is serialized
+    auto ifNoneMatch = request.value("If-None-Match");
+    if (not ifNoneMatch.isEmpty() and cableType.matches(ifNoneMatch)) {
+      QHttpServerResponse response(StatusCode::NotModified);
+      response.addHeader("ETag", cableType.etag(encoding));
+      response.addHeader("Vary", "Accept-Encoding");
+      return response;
+    }
+
+    auto body = cableType.encoded(encoding);
+    if (body.isEmpty()) {
+      encoding = ContentEncoding::Identity;
+      body = cableType.json();
+    }
+
+    // Delayed response may be sent after cable type is replaced or deleted
+    // and its snapshot unmapped, so it owns JSON read from snapshot
+    if (ContentEncoding::Identity == encoding and cableType.isBacked()) {
+      body = QByteArray(body.constData(), body.size());
+    }
+
+    QHttpServerResponse response(mimeType, body, StatusCode::Ok);
+    response.addHeader("ETag", cableType.etag(encoding));
+    response.addHeader("Vary", "Accept-Encoding");
+    if (ContentEncoding::Identity != encoding) {
+      response.addHeader("Content-Encoding", nameOf(encoding));
+    }
+    return response;
+  }
+
+  QString causeOf(Error error) {
+    return QString::fromUtf8(
+        errorDefinitions[static_cast<std::size_t>(error)].cause);
+  }
+
+  QHttpServerResponse responseByState(MockApiServer::State state) {
+    using State = MockApiServer::State;
+
+    switch (state) {
+
+    case State::Unauthorized:
+      return makeResponse(Error::Unauthorized);
+
+    case State::AttemptToAccessAnotherCustomerData:
+      return makeResponse(Error::AttemptToAccessAnotherCustomerData);
+
+    case State::NonExistingCustomerId:
+      return makeResponse(Error::NonExistingCustomerId);
+
+    case State::CableTypeAlreadyExists:
+      return makeResponse(Error::CableTypeAlreadyExists);
+
+    case State::BusinessRulesViolated:
+      return makeResponse(Error::BusinessRulesViolated);
+
+    case State::DatabaseRejectedTransaction:
+      return makeResponse(Error::DatabaseRejectedTransaction);
+
+    case State::DatabaseUnhandledError:
+      return makeResponse(Error::DatabaseUnhandledError);
+
+    case State::DatabaseRequestTimeout:
+      return makeResponse(Error::DatabaseRequestTimeout);
+
+    case State::DatabaseConnectionError:
+      return makeResponse(Error::DatabaseConnectionError);
+
+    case State::TooLargePayload:
+      return makeResponse(Error::TooLargePayload);
+
+    default:
+      break;
+    }
+
+    return makeResponse(Error::UnexpectedError);
+  }
+
+  const char* nameOf(MockApiServer::State state) {
+    return stateNames[static_cast<std::size_t>(state)];
+  }
+
+  QByteArray makeRawResponse(Error error) {
+    const auto& definition = errorDefinitions[static_cast<std::size_t>(error)];
+    const auto& [body, statusCode] =
+        preparedErrors()[static_cast<std::size_t>(error)];
+    return QString("HTTP/1.1 %1 %2\r\n"
+                   "Content-Type: application/json\r\n"
+                   "Content-Length: %3\r\n"
+                   "Connection: close\r\n"
+                   "\r\n")
+               .arg(static_cast<int>(statusCode))
+               .arg(QString::fromUtf8(definition.cause))
+               .arg(body.size())
+               .toUtf8() +
+           body;
+  }
+} // namespace test::api
@@ -0,0 +1,73 @@
+#pragma once
+#include "MockApiServer.h"
+#include "StoredCableType.h"
+
+#include <QHttpServerRequest>
+#include <QHttpServerResponse>
+
+namespace test::api {
+  enum class Error {
+    Unauthorized,
+    AttemptToAccessAnotherCustomerData,
+    NonExistingCustomerId,
+    CableTypeAlreadyExists,
+    BusinessRulesViolated,
+    DatabaseRejectedTransaction,
+    DatabaseUnhandledError,
+    DatabaseRequestTimeout,
+    DatabaseConnectionError,
+    TooLargePayload,
+    CableTypeReferencedByOtherEntities,
+    IdProvidedInRequest,
+    IdNotProvidedInRequest,
+    IdMismatch,
+    MissingRequiredKeys,
+    RotationFrequencyInvalidSpecification,
+    RotationFrequencyUnitInvalidValue,
+    ImmutableKeysChange,
+    InvalidIdFormat,
+    NotFoundById,
+    NotFoundByIdentifier,
+    NotFoundByCatId,
+    NotFoundByCustomerCode,
+    PayloadExceedsLimit,
+    InvalidJsonObject,
+    InvalidCursor,
+    InvalidPageSize,
+    InvalidRangeQuery,
+    InvalidSelection,
+    UnexpectedError
+  };
+
+  /*
+   * Serializes error bodies, done on first use otherwise.
+   */
+  void prepareResponses();
+
+  QHttpServerResponse makeResponse(Error error);
+
+  /*
+   * Response with stored cable type and its ETag,
+   * compressed if request accepts it.
+   * Bodyless 304 if request If-None-Match matches cable type.
+   */
+  QHttpServerResponse makeResponse(const QHttpServerRequest& request,
+                                   const StoredCableType& cableType);
+
+  /*
+   * Cause reported in body of error response.
+   */
+  QString causeOf(Error error);
+  QHttpServerResponse responseByState(MockApiServer::State state);
+
+  /*
+   * Name of state as reported by metrics and access log.
+   */
+  const char* nameOf(MockApiServer::State state);
+
+  /*
+   * Complete HTTP/1.1 response closing connection,
+   * for requests rejected before they reach HTTP server.
+   */
+  QByteArray makeRawResponse(Error error);
+} // namespace test::api
@@ -0,0 +1,138 @@
+#include "Seeding.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QThread>
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+  using test::api::CableTypeStore;
+
+  struct Chunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+  };
+
+  /*
+   * Splits data into about equal chunks, each ending after newline
+   * (or at end of data), so no line is split between chunks.
+   */
+  std::vector<Chunk>
+  splitAtLines(const char* data, qint64 size, std::size_t count) {
+    std::vector<Chunk> chunks;
+    const auto* end = data + size;
+    const auto* begin = data;
+    for (std::size_t part = 1; part <= count and begin < end; ++part) {
+      const auto* chunkEnd = end;
+      if (part < count) {
+        const auto* estimate =
+            std::max(begin, data + size * static_cast<qint64>(part) /
+                                    static_cast<qint64>(count));
+        chunkEnd = std::find(estimate, end, '\n');
+        if (chunkEnd != end) {
+          ++chunkEnd;
+        }
+      }
+      chunks.push_back({ begin, chunkEnd });
+      begin = chunkEnd;
+    }
+    return chunks;
+  }
+
+  struct Parsed {
+    std::vector<CableTypeStore::Entry> cableTypes;
+    std::vector<test::api::CableType> typed;
+    std::size_t rejected = 0;
+  };
+
+  /*
+   * Stored and typed cable types are built here as well,
+   * so their serialization, hashing and conversion run in parallel too.
+   */
+  Parsed parseLines(Chunk chunk) {
+    Parsed parsed;
+    for (const auto* begin = chunk.begin; begin < chunk.end;) {
+      const auto* end = std::find(begin, chunk.end, '\n');
+      auto blank = std::all_of(begin, end, [](char character) {
+        return std::isspace(static_cast<unsigned char>(character));
+      });
+      if (not blank) {
+        // Raw data refers to mapped file, no copy of line is made
+        auto line = QByteArray::fromRawData(begin, end - begin);
+        auto cableType = QJsonDocument::fromJson(line).object();
+        if (cableType.value("id").toString().isEmpty()) {
+          ++parsed.rejected;
+        } else {
+          parsed.typed.push_back(test::api::CableType::fromJson(cableType));
+          parsed.cableTypes.push_back(
+              std::make_shared<const test::api::StoredCableType>(
+                  std::move(cableType)));
+        }
+      }
+      begin = end + 1;
+    }
+    return parsed;
+  }
+} // namespace
+
+namespace test::api {
+  SeedResult seedFromNdjson(CableTypeStore& store,
+                            const QString& path,
+                            std::size_t threadCount) {
+    QFile file(path);
+    if (not file.open(QIODevice::ReadOnly)) {
+      throw std::runtime_error(
+          QString("Failed to open seed file %1").arg(path).toStdString());
+    }
+    if (0 == file.size()) {
+      return {};
+    }
+    const auto* data = reinterpret_cast<const char*>(file.map(0, file.size()));
+    if (nullptr == data) {
+      throw std::runtime_error(
+          QString("Failed to map seed file %1").arg(path).toStdString());
+    }
+
+    if (0 == threadCount) {
+      threadCount = std::max(1, QThread::idealThreadCount());
+    }
+    auto chunks = splitAtLines(data, file.size(), threadCount);
+    std::vector<Parsed> parsed(chunks.size());
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size());
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+      threads.emplace_back(
+          [&parsed, &chunks, i] { parsed[i] = parseLines(chunks[i]); });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    std::size_t parsedCount = 0;
+    SeedResult result;
+    for (const auto& chunk : parsed) {
+      parsedCount += chunk.cableTypes.size();
+      result.rejected += chunk.rejected;
+    }
+    std::vector<CableTypeStore::Entry> cableTypes;
+    std::vector<CableType> typed;
+    cableTypes.reserve(parsedCount);
+    typed.reserve(parsedCount);
+    for (auto& chunk : parsed) {
+      std::move(chunk.cableTypes.begin(),
+                chunk.cableTypes.end(),
+                std::back_inserter(cableTypes));
+      std::move(chunk.typed.begin(),
+                chunk.typed.end(),
+                std::back_inserter(typed));
+    }
+
+    result.stored = store.insert(std::move(cableTypes), std::move(typed));
+    result.rejected += parsedCount - result.stored;
+    return result;
+  }
+} // namespace test::api
@@ -0,0 +1,28 @@
+#pragma once
+#include "CableTypeStore.h"
+
+#include <QString>
+
+namespace test::api {
+  /*
+   * Outcome of seeding store from file.
+   */
+  struct SeedResult {
+    std::size_t stored = 0;
+
+    /*
+     * Lines which are not JSON objects with id, or with id already taken.
+     */
+    std::size_t rejected = 0;
+  };
+
+  /*
+   * Stores cable types from newline delimited JSON file, each line is
+   * cable type with "id". File is memory mapped and split at line
+   * boundaries, chunks are parsed on threads (0 uses one per core).
+   * Throws std::runtime_error if file can't be read.
+   */
+  SeedResult seedFromNdjson(CableTypeStore& store,
+                            const QString& path,
+                            std::size_t threadCount = 0);
+} // namespace test::api
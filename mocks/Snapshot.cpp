@@ -0,0 +1,339 @@
+#include "Snapshot.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+  using test::api::CableTypeStore;
+  using test::api::StoredCableType;
+
+  static constexpr char snapshotMagic[8] = { 'A', 'P', 'I', 'M',
+                                             'S', 'N', 'A', 'P' };
+  static constexpr quint32 byteOrderMark = 0x01020304;
+
+  struct Header {
+    char magic[8];
+    quint32 version;
+    quint32 byteOrder;
+    quint64 recordCount;
+    quint64 recordsOffset;
+    quint64 dataOffset;
+    quint64 fileSize;
+    quint64 stringsOffset;
+    quint64 stringCount;
+  };
+  static_assert(sizeof(Header) == 64);
+
+  /*
+   * Offsets are from beginning of file, keys follow each other
+   * in order id, identifier, customer code, then string table indexes
+   * of property names (unaligned).
+   * Typed fields of columns follow, units and manufacturer refer
+   * to string table by index, so equal strings are shared when loaded.
+   */
+  struct Record {
+    quint64 jsonOffset;
+    quint64 keysOffset;
+    quint32 jsonSize;
+    quint16 idSize;
+    quint16 identifierSize;
+    quint16 customerCodeSize;
+    quint16 propertyCount;
+    qint32 catid;
+    char digest[StoredCableType::digestSize];
+    double values[test::api::numericFieldCount];
+    quint32 units[test::api::numericFieldCount];
+    quint32 manufacturerId;
+    quint32 manufacturerName;
+    quint32 padding;
+  };
+  static_assert(sizeof(Record) == 168);
+  static_assert(sizeof(Record) % alignof(double) == 0);
+
+  static constexpr qsizetype maxKeySize = 0xffff;
+
+  std::runtime_error snapshotError(const QString& message,
+                                   const QString& path) {
+    return std::runtime_error(
+        QString("%1 %2").arg(message, path).toStdString());
+  }
+
+  /*
+   * Snapshot file stays mapped while it is alive.
+   */
+  struct MappedFile {
+    QFile file;
+    const char* data = nullptr;
+    qint64 size = 0;
+  };
+
+  void validate(const Header& header, const MappedFile& mapped) {
+    auto recordsEnd =
+        header.recordsOffset + header.recordCount * sizeof(Record);
+    if (0 != std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) or
+        byteOrderMark != header.byteOrder or
+        test::api::snapshotVersion != header.version or
+        static_cast<quint64>(mapped.size) != header.fileSize or
+        0 != header.recordsOffset % alignof(Record) or
+        header.recordsOffset < sizeof(Header) or
+        header.recordCount > header.fileSize / sizeof(Record) or
+        recordsEnd > header.stringsOffset or
+        header.stringsOffset > header.dataOffset or
+        header.stringCount > header.dataOffset - header.stringsOffset or
+        header.dataOffset > header.fileSize) {
+      throw snapshotError("Invalid or incompatible snapshot",
+                          mapped.file.fileName());
+    }
+  }
+
+  bool isWithin(const Record& record, const Header& header) {
+    auto keysSize = quint64{ record.idSize } + record.identifierSize +
+                    record.customerCodeSize +
+                    quint64{ record.propertyCount } * sizeof(quint32);
+    return record.jsonOffset >= header.dataOffset and
+           record.jsonOffset <= header.fileSize and
+           record.jsonSize <= header.fileSize - record.jsonOffset and
+           record.keysOffset >= header.dataOffset and
+           record.keysOffset <= header.fileSize and
+           keysSize <= header.fileSize - record.keysOffset;
+  }
+
+  /*
+   * String table is size of each string followed by its UTF-8 bytes.
+   */
+  QByteArray stringTableOf(const test::api::StringPool& strings) {
+    QByteArray table;
+    for (test::api::StringPool::Id id = 0; id < strings.size(); ++id) {
+      auto bytes = strings.at(id).toUtf8();
+      auto size = static_cast<quint32>(bytes.size());
+      table.append(reinterpret_cast<const char*>(&size), sizeof(size));
+      table.append(bytes);
+    }
+    return table;
+  }
+
+  std::vector<QString> readStringTable(const Header& header,
+                                       const MappedFile& mapped) {
+    std::vector<QString> strings;
+    strings.reserve(header.stringCount);
+    auto offset = header.stringsOffset;
+    for (quint64 i = 0; i < header.stringCount; ++i) {
+      quint32 size = 0;
+      if (header.dataOffset - offset < sizeof(size)) {
+        throw snapshotError("Corrupted snapshot", mapped.file.fileName());
+      }
+      std::memcpy(&size, mapped.data + offset, sizeof(size));
+      offset += sizeof(size);
+      if (header.dataOffset - offset < size) {
+        throw snapshotError("Corrupted snapshot", mapped.file.fileName());
+      }
+      strings.push_back(QString::fromUtf8(mapped.data + offset, size));
+      offset += size;
+    }
+    return strings;
+  }
+
+  bool refersWithin(const Record& record, std::size_t stringCount) {
+    return std::all_of(std::begin(record.units),
+                       std::end(record.units),
+                       [stringCount](auto unit) {
+                         return unit < stringCount;
+                       }) and
+           record.manufacturerId < stringCount and
+           record.manufacturerName < stringCount;
+  }
+} // namespace
+
+namespace test::api {
+  void saveSnapshot(const CableTypeStore& store, const QString& path) {
+    // Records are filled from columns, so no document is parsed
+    std::vector<CableTypeStore::Entry> entries;
+    std::vector<Record> records;
+    std::vector<QByteArray> keys;
+    QByteArray strings;
+    quint64 stringCount = 0;
+    store.scan([&](const CableTypeColumns& columns,
+                   std::span<const CableTypeStore::Entry> stored) {
+      entries.assign(stored.begin(), stored.end());
+      records.resize(stored.size());
+      keys.resize(stored.size());
+      for (std::size_t row = 0; row < stored.size(); ++row) {
+        auto idBytes = columns.id(row).toUtf8();
+        auto identifierBytes = columns.identifier(row).toUtf8();
+        auto customerCodeBytes =
+            columns.strings().at(columns.customerCodes()[row]).toUtf8();
+        auto propertyNames = columns.propertyNames(row);
+        if (std::max({ idBytes.size(),
+                       identifierBytes.size(),
+                       customerCodeBytes.size(),
+                       static_cast<qsizetype>(propertyNames.size()) }) >
+            maxKeySize) {
+          throw snapshotError("Key too long for snapshot", path);
+        }
+        keys[row] = idBytes + identifierBytes + customerCodeBytes;
+        keys[row].append(reinterpret_cast<const char*>(propertyNames.data()),
+                         static_cast<qsizetype>(propertyNames.size_bytes()));
+
+        auto& record = records[row];
+        record.idSize = static_cast<quint16>(idBytes.size());
+        record.identifierSize = static_cast<quint16>(identifierBytes.size());
+        record.customerCodeSize =
+            static_cast<quint16>(customerCodeBytes.size());
+        record.propertyCount = static_cast<quint16>(propertyNames.size());
+        record.catid = columns.catids()[row];
+        for (auto field : numericFields) {
+          auto index = static_cast<std::size_t>(field);
+          record.values[index] = columns.values(field)[row];
+          record.units[index] = columns.units(field)[row];
+        }
+        record.manufacturerId = columns.manufacturerIds()[row];
+        record.manufacturerName = columns.manufacturerNames()[row];
+      }
+      strings = stringTableOf(columns.strings());
+      stringCount = columns.strings().size();
+    });
+
+    Header header{};
+    std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+    header.version = snapshotVersion;
+    header.byteOrder = byteOrderMark;
+    header.recordCount = entries.size();
+    header.recordsOffset = sizeof(Header);
+    header.stringsOffset = sizeof(Header) + entries.size() * sizeof(Record);
+    header.stringCount = stringCount;
+    header.dataOffset = header.stringsOffset + strings.size();
+
+    auto offset = header.dataOffset;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      const auto& entry = *entries[i];
+      auto& record = records[i];
+      record.jsonOffset = offset;
+      record.jsonSize = static_cast<quint32>(entry.json().size());
+      record.keysOffset = offset + record.jsonSize;
+      auto digest = entry.digest();
+      std::memcpy(record.digest, digest.constData(), sizeof(record.digest));
+      offset = record.keysOffset + keys[i].size();
+    }
+    header.fileSize = offset;
+
+    QSaveFile file(path);
+    if (not file.open(QIODevice::WriteOnly)) {
+      throw snapshotError("Failed to write snapshot", path);
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()),
+               static_cast<qint64>(records.size() * sizeof(Record)));
+    file.write(strings);
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+      file.write(entries[i]->json());
+      file.write(keys[i]);
+    }
+    if (not file.commit()) {
+      throw snapshotError("Failed to write snapshot", path);
+    }
+  }
+
+  std::size_t loadSnapshot(CableTypeStore& store, const QString& path) {
+    auto mapped = std::make_shared<MappedFile>();
+    mapped->file.setFileName(path);
+    if (not mapped->file.open(QIODevice::ReadOnly)) {
+      throw snapshotError("Failed to open snapshot", path);
+    }
+    mapped->size = mapped->file.size();
+    if (mapped->size < static_cast<qint64>(sizeof(Header))) {
+      throw snapshotError("Invalid or incompatible snapshot", path);
+    }
+    mapped->data =
+        reinterpret_cast<const char*>(mapped->file.map(0, mapped->size));
+    if (nullptr == mapped->data) {
+      throw snapshotError("Failed to map snapshot", path);
+    }
+
+    Header header;
+    std::memcpy(&header, mapped->data, sizeof(header));
+    validate(header, *mapped);
+    const auto* records =
+        reinterpret_cast<const Record*>(mapped->data + header.recordsOffset);
+    auto count = static_cast<std::size_t>(header.recordCount);
+    if (0 == count) {
+      return 0;
+    }
+
+    // Strings are shared by typed cable types, so they are read once
+    auto strings = readStringTable(header, *mapped);
+
+    // Stored and typed cable types are made on all cores
+    std::vector<CableTypeStore::Entry> entries(count);
+    std::vector<CableType> typed(count);
+    std::atomic<bool> corrupted = false;
+    auto threadCount =
+        std::clamp<std::size_t>(QThread::idealThreadCount(), 1, count);
+    std::vector<std::thread> threads;
+    for (std::size_t part = 0; part < threadCount; ++part) {
+      threads.emplace_back([&, part] {
+        auto begin = count * part / threadCount;
+        auto end = count * (part + 1) / threadCount;
+        for (auto i = begin; i < end; ++i) {
+          const auto& record = records[i];
+          if (not isWithin(record, header) or
+              not refersWithin(record, strings.size())) {
+            corrupted = true;
+            return;
+          }
+          entries[i] = std::make_shared<const StoredCableType>(
+              QByteArray::fromRawData(mapped->data + record.jsonOffset,
+                                      record.jsonSize),
+              QByteArrayView(record.digest, sizeof(record.digest)),
+              mapped);
+
+          auto& cableType = typed[i];
+          const auto* key = mapped->data + record.keysOffset;
+          cableType.id = QString::fromUtf8(key, record.idSize);
+          key += record.idSize;
+          cableType.identifier = QString::fromUtf8(key, record.identifierSize);
+          key += record.identifierSize;
+          cableType.customerCode =
+              QString::fromUtf8(key, record.customerCodeSize);
+          key += record.customerCodeSize;
+          for (quint16 property = 0; property < record.propertyCount;
+               ++property) {
+            quint32 name = 0;
+            std::memcpy(&name, key, sizeof(name));
+            key += sizeof(name);
+            if (name >= strings.size()) {
+              corrupted = true;
+              return;
+            }
+            cableType.properties.push_back({ strings[name], {} });
+          }
+          cableType.catid = record.catid;
+          for (auto field : numericFields) {
+            auto index = static_cast<std::size_t>(field);
+            const auto& unit = strings[record.units[index]];
+            if (not std::isnan(record.values[index]) or not unit.isEmpty()) {
+              cableType.measure(field) = Measure{ record.values[index], unit };
+            }
+          }
+          cableType.manufacturerId = strings[record.manufacturerId];
+          cableType.manufacturerName = strings[record.manufacturerName];
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    if (corrupted) {
+      throw snapshotError("Corrupted snapshot", path);
+    }
+
+    return store.insert(std::move(entries), std::move(typed));
+  }
+} // namespace test::api
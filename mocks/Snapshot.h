@@ -0,0 +1,35 @@
+#pragma once
+#include "CableTypeStore.h"
+
+#include <QString>
+
+namespace test::api {
+  /*
+   * Binary snapshot of store, versioned and laid out to be memory mapped:
+   * fixed size header, fixed size record per cable type with offsets
+   * of its compact JSON and index keys, content hash ETags are made of
+   * and its typed fields kept in store columns, then string table
+   * typed fields refer to, followed by the bytes offsets point to.
+   * Multi byte fields are in byte order of machine which saved snapshot,
+   * snapshot of other byte order is rejected.
+   */
+  inline constexpr quint32 snapshotVersion = 3;
+
+  /*
+   * Written to temporary file renamed over path when complete,
+   * so readers never see partial snapshot.
+   * Throws std::runtime_error if snapshot can't be written.
+   */
+  void saveSnapshot(const CableTypeStore& store, const QString& path);
+
+  /*
+   * Maps snapshot and stores its cable types, returns number stored
+   * (cable types with ids already taken are skipped).
+   * Nothing is parsed or hashed: stored JSON refers to mapped file,
+   * which stays mapped while any of its cable types is alive,
+   * columns are filled from typed fields of records.
+   * Throws std::runtime_error if file is missing, of other version
+   * or corrupted.
+   */
+  std::size_t loadSnapshot(CableTypeStore& store, const QString& path);
+} // namespace test::api
@@ -0,0 +1,98 @@
+#include "StoredCableType.h"
+
+#include <QCryptographicHash>
+#include <QJsonDocument>
+#include <QList>
+#include <algorithm>
+
+namespace {
+  using test::api::ContentEncoding;
+
+  /*
+   * Content hash is fingerprint of document, not a security measure,
+   * so the fastest hash Qt provides is used.
+   */
+  QByteArray digestOf(const QByteArray& json) {
+    return QCryptographicHash::hash(json, QCryptographicHash::Md5);
+  }
+
+  std::array<QByteArray, 3> makeEtags(QByteArrayView digest) {
+    auto hash = digest.toByteArray().toHex();
+    std::array<QByteArray, 3> etags;
+    for (auto encoding : { ContentEncoding::Identity,
+                           ContentEncoding::Gzip,
+                           ContentEncoding::Deflate }) {
+      auto suffix = ContentEncoding::Identity == encoding
+                        ? QByteArray()
+                        : '-' + test::api::nameOf(encoding);
+      etags[static_cast<std::size_t>(encoding)] = '"' + hash + suffix + '"';
+    }
+    return etags;
+  }
+} // namespace
+
+namespace test::api {
+  StoredCableType::StoredCableType(QJsonObject cableType)
+    : m_json(QJsonDocument(cableType).toJson(QJsonDocument::Compact))
+    , m_etags(makeEtags(digestOf(m_json))) { }
+
+  StoredCableType::StoredCableType(QByteArray json,
+                                   QByteArrayView digest,
+                                   std::shared_ptr<const void> backing)
+    : m_backing(std::move(backing))
+    , m_json(std::move(json))
+    , m_etags(makeEtags(digest)) { }
+
+  QJsonObject StoredCableType::cableType() const {
+    return QJsonDocument::fromJson(m_json).object();
+  }
+
+  const QByteArray& StoredCableType::json() const noexcept {
+    return m_json;
+  }
+
+  bool StoredCableType::isBacked() const noexcept {
+    return nullptr != m_backing;
+  }
+
+  const QByteArray& StoredCableType::encoded(ContentEncoding encoding) const {
+    if (ContentEncoding::Identity == encoding) {
+      return m_json;
+    }
+
+    auto& encoded = m_encoded[static_cast<std::size_t>(encoding) - 1];
+    std::call_once(encoded.once,
+                   [&] { encoded.body = encode(m_json, encoding); });
+    return encoded.body;
+  }
+
+  const QByteArray&
+  StoredCableType::etag(ContentEncoding encoding) const noexcept {
+    return m_etags[static_cast<std::size_t>(encoding)];
+  }
+
+  QByteArray StoredCableType::digest() const {
+    // Identity ETag is quoted hex of digest
+    const auto& etag = m_etags[static_cast<std::size_t>(
+        ContentEncoding::Identity)];
+    return QByteArray::fromHex(etag.mid(1, etag.size() - 2));
+  }
+
+  bool StoredCableType::matches(QByteArrayView ifNoneMatch) const {
+    for (auto tag : ifNoneMatch.toByteArray().split(',')) {
+      tag = tag.trimmed();
+      if ("*" == tag) {
+        return true;
+      }
+
+      // If-None-Match uses weak comparison
+      if (tag.startsWith("W/")) {
+        tag = tag.mid(2);
+      }
+      if (std::find(m_etags.begin(), m_etags.end(), tag) != m_etags.end()) {
+        return true;
+      }
+    }
+    return false;
+  }
+} // namespace test::api
@@ -0,0 +1,84 @@
+#pragma once
+#include "Compression.h"
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <array>
+#include <memory>
+#include <mutex>
+
+namespace test::api {
+  /*
+   * Serialized forms of cable type kept by CableTypeStore.
+   * JSON and ETags are made once on write, compressed forms once on first use,
+   * so responses never serialize or compress stored cable type again.
+   * Parsed document is not kept, typed fields live in store columns.
+   * Never modified after creation, replacing cable type creates new one.
+   */
+  class StoredCableType {
+
+  public:
+    /*
+     * Content hash of JSON, raw MD5.
+     */
+    static constexpr qsizetype digestSize = 16;
+
+    explicit StoredCableType(QJsonObject cableType);
+
+    /*
+     * Cable type already serialized and hashed, e.g. read from snapshot.
+     * JSON may refer to memory kept alive by backing.
+     */
+    StoredCableType(QByteArray json,
+                    QByteArrayView digest,
+                    std::shared_ptr<const void> backing);
+
+    /*
+     * Parses JSON on every call, for rare uses only, e.g. validating update.
+     */
+    QJsonObject cableType() const;
+
+    /*
+     * Compact JSON of cable type.
+     */
+    const QByteArray& json() const noexcept;
+
+    /*
+     * Whether JSON refers to memory of backing instead of owning it,
+     * so copies of it must not outlive this cable type.
+     */
+    bool isBacked() const noexcept;
+
+    /*
+     * JSON encoded for response, safe to call from multiple threads.
+     */
+    const QByteArray& encoded(ContentEncoding encoding) const;
+
+    /*
+     * Strong ETag of JSON encoded with encoding, e.g. "<content hash>-gzip".
+     */
+    const QByteArray& etag(ContentEncoding encoding) const noexcept;
+
+    /*
+     * Content hash ETags are made of.
+     */
+    QByteArray digest() const;
+
+    /*
+     * Whether If-None-Match request header matches any encoding
+     * of this cable type, i.e. client already has it.
+     */
+    bool matches(QByteArrayView ifNoneMatch) const;
+
+  private:
+    struct Encoded {
+      std::once_flag once;
+      QByteArray body;
+    };
+
+    std::shared_ptr<const void> m_backing;
+    QByteArray m_json;
+    std::array<QByteArray, 3> m_etags;
+    mutable std::array<Encoded, 2> m_encoded;
+  };
+} // namespace test::api
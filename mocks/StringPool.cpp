@@ -0,0 +1,58 @@
+#include "StringPool.h"
+
+namespace test::api {
+  StringPool::StringPool() {
+    m_strings.emplace_back();
+    m_references.push_back(0);
+    m_ids.emplace(QString(), empty);
+  }
+
+  StringPool::Id StringPool::intern(const QString& string) {
+    if (string.isEmpty()) {
+      return empty;
+    }
+    auto next = m_released.empty() ? static_cast<Id>(m_strings.size())
+                                   : m_released.back();
+    auto [existing, inserted] = m_ids.try_emplace(string, next);
+    if (inserted) {
+      if (m_released.empty()) {
+        m_strings.push_back(string);
+        m_references.push_back(0);
+      } else {
+        m_released.pop_back();
+        m_strings[next] = string;
+      }
+    }
+    ++m_references[existing->second];
+    return existing->second;
+  }
+
+  void StringPool::release(Id id) {
+    if (empty == id or 0 != --m_references[id]) {
+      return;
+    }
+    m_ids.erase(m_strings[id]);
+    m_strings[id] = QString();
+    m_released.push_back(id);
+  }
+
+  std::optional<StringPool::Id>
+  StringPool::find(const QString& string) const {
+    if (string.isEmpty()) {
+      return empty;
+    }
+    auto existing = m_ids.find(string);
+    if (existing == m_ids.end()) {
+      return std::nullopt;
+    }
+    return existing->second;
+  }
+
+  const QString& StringPool::at(Id id) const noexcept {
+    return m_strings[id];
+  }
+
+  std::size_t StringPool::size() const noexcept {
+    return m_strings.size();
+  }
+} // namespace test::api
@@ -0,0 +1,63 @@
+#pragma once
+#include <QHash>
+#include <QString>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Keeps single copy of each distinct string, e.g. unit or manufacturer,
+   * so columns refer to strings by small id.
+   * Strings are counted by references, string released by its last
+   * reference is removed and its id reused, so pool holds only strings
+   * in use however many come and go.
+   * Not thread safe, owner guards it.
+   */
+  class StringPool {
+
+  public:
+    using Id = quint32;
+
+    /*
+     * Id of empty string, which is in pool from the start.
+     */
+    static constexpr Id empty = 0;
+
+    StringPool();
+    ~StringPool() = default;
+
+    /*
+     * Id of string, adds reference to it.
+     */
+    Id intern(const QString& string);
+
+    /*
+     * Drops reference added by intern, empty string is never removed.
+     */
+    void release(Id id);
+
+    /*
+     * Id of string if it was interned.
+     */
+    std::optional<Id> find(const QString& string) const;
+
+    /*
+     * Reference stays valid until string is released,
+     * released id refers to empty string until it is reused.
+     */
+    const QString& at(Id id) const noexcept;
+
+    /*
+     * Number of ids, released ones waiting for reuse included.
+     */
+    std::size_t size() const noexcept;
+
+  private:
+    std::deque<QString> m_strings;
+    std::vector<quint32> m_references;
+    std::vector<Id> m_released;
+    std::unordered_map<QString, Id> m_ids;
+  };
+} // namespace test::api
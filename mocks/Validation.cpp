@@ -0,0 +1,52 @@
+#include "Validation.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace test::api {
+  bool validateRotationFrequencyUnitValues(QString&& value) noexcept {
+    static constexpr std::array<std::string, 3> rotationFrequencyUnitValues = {
+      "d", "w", "m"
+    };
+
+    return std::none_of(
+        rotationFrequencyUnitValues.begin(),
+        rotationFrequencyUnitValues.end(),
+        [valueToValidate = value.toStdString()](const auto& value) -> bool {
+          return value == valueToValidate;
+        });
+  }
+
+  std::optional<Error> validateRotationFrequency(const QJsonObject& cableType) {
+    if (not cableType.contains("rotationFrequency")) {
+      return std::nullopt;
+    }
+
+    auto rotationFrequency = cableType.value("rotationFrequency");
+    if (not rotationFrequency.isObject() or
+        not rotationFrequency.toObject().contains("unit")) {
+      return Error::RotationFrequencyInvalidSpecification;
+    }
+
+    if (validateRotationFrequencyUnitValues(
+            rotationFrequency.toObject().value("unit").toString())) {
+      return Error::RotationFrequencyUnitInvalidValue;
+    }
+
+    return std::nullopt;
+  }
+
+  std::optional<Error> validateNewCableType(const QJsonObject& cableType) {
+    if (cableType.contains("id")) {
+      return Error::IdProvidedInRequest;
+    }
+
+    if (not cableType.contains("catid") or
+        not cableType.contains("identifier")) {
+      return Error::MissingRequiredKeys;
+    }
+
+    return validateRotationFrequency(cableType);
+  }
+} // namespace test::api
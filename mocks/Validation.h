@@ -0,0 +1,25 @@
+#pragma once
+#include "Responses.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <optional>
+
+namespace test::api {
+  /*
+   * Returns true if rotation frequency unit is NOT one of allowed values.
+   */
+  bool validateRotationFrequencyUnitValues(QString&& value) noexcept;
+
+  /*
+   * Checks "rotationFrequency" of cable type, if present.
+   * Returns error to respond with if it is invalid.
+   */
+  std::optional<Error> validateRotationFrequency(const QJsonObject& cableType);
+
+  /*
+   * Checks cable type sent to be created.
+   * Returns error to respond with if it is invalid.
+   */
+  std::optional<Error> validateNewCableType(const QJsonObject& cableType);
+} // namespace test::api
@@ -0,0 +1,81 @@
+#include "WorkerPool.h"
+
+#include <QHostAddress>
+#include <stdexcept>
+
+namespace {
+  /*
+   * HTTP server serves connections of listening TCP servers only
+   * (since Qt 6.8 it refuses to bind other ones),
+   * so worker listens on ephemeral local port besides taking connections
+   * accepted by pool.
+   */
+  bool bindWorker(QHttpServer& httpServer,
+                  test::api::LimitingTcpServer* worker) {
+    if (not worker->listen(QHostAddress::LocalHost, 0)) {
+      return false;
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 8, 0)
+    return httpServer.bind(worker);
+#else
+    httpServer.bind(worker);
+    return true;
+#endif
+  }
+} // namespace
+
+namespace test::api {
+  WorkerPool::WorkerPool(std::size_t workerCount,
+                         const LimitingTcpServer::Limits& limits,
+                         const RoutesSetup& setupRoutes) {
+    // Every worker is bound before any thread starts,
+    // so failure leaves nothing running
+    std::vector<std::unique_ptr<QHttpServer>> httpServers;
+    httpServers.reserve(workerCount);
+    m_workers.reserve(workerCount);
+    for (std::size_t i = 0; i < workerCount; ++i) {
+      auto& httpServer =
+          httpServers.emplace_back(std::make_unique<QHttpServer>());
+      setupRoutes(*httpServer);
+
+      auto* worker = new LimitingTcpServer(limits);
+      if (not bindWorker(*httpServer, worker)) {
+        delete worker;
+        throw std::runtime_error("API Mock failed to start worker thread");
+      }
+      m_workers.push_back(worker);
+    }
+
+    m_threads.reserve(workerCount);
+    for (auto& httpServer : httpServers) {
+      auto thread = std::make_unique<QThread>();
+      httpServer->moveToThread(thread.get());
+      QObject::connect(thread.get(),
+                       &QThread::finished,
+                       httpServer.release(),
+                       &QObject::deleteLater);
+      thread->start();
+      m_threads.push_back(std::move(thread));
+    }
+  }
+
+  WorkerPool::~WorkerPool() {
+    close();
+    for (auto& thread : m_threads) {
+      thread->quit();
+      thread->wait();
+    }
+  }
+
+  void WorkerPool::incomingConnection(qintptr socketDescriptor) {
+    auto* worker = m_workers[m_nextWorker];
+    m_nextWorker = (m_nextWorker + 1) % m_workers.size();
+
+    QMetaObject::invokeMethod(
+        worker,
+        [worker, socketDescriptor] {
+          worker->takeConnection(socketDescriptor);
+        },
+        Qt::QueuedConnection);
+  }
+} // namespace test::api
@@ -0,0 +1,36 @@
+#pragma once
+#include "LimitingTcpServer.h"
+
+#include <QHttpServer>
+#include <QTcpServer>
+#include <QThread>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace test::api {
+  /*
+   * Accepts connections on thread owning it and hands them over
+   * round robin to HTTP servers running on worker threads,
+   * each worker runs its own event loop.
+   * Workers reject request bodies exceeding limits.
+   */
+  class WorkerPool : public QTcpServer {
+
+  public:
+    using RoutesSetup = std::function<void(QHttpServer&)>;
+
+    WorkerPool(std::size_t workerCount,
+               const LimitingTcpServer::Limits& limits,
+               const RoutesSetup& setupRoutes);
+    ~WorkerPool() override;
+
+  protected:
+    void incomingConnection(qintptr socketDescriptor) override;
+
+  private:
+    std::vector<std::unique_ptr<QThread>> m_threads;
+    std::vector<LimitingTcpServer*> m_workers;
+    std::size_t m_nextWorker = 0;
+  };
+} // namespace test::api
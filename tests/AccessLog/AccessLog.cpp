@@ -0,0 +1,81 @@
+#include <MockApiServer.h>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <utils.h>
+
+class AccessLog : public QObject {
+  Q_OBJECT
+
+private slots:
+  void writeRecordsTest();
+};
+
+namespace {
+  QNetworkRequest makeGetByIdRequest(const test::api::MockApiServer& apiServer,
+                                     const QString& token) {
+    return test::utils::makeRequest(
+        apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1"), token);
+  }
+
+  QList<QJsonObject> readRecords(const QString& path) {
+    QFile file(path);
+    if (not file.open(QIODevice::ReadOnly)) {
+      return {};
+    }
+    QList<QJsonObject> records;
+    for (const auto& line : file.readAll().split('\n')) {
+      if (not line.isEmpty()) {
+        records.append(QJsonDocument::fromJson(line).object());
+      }
+    }
+    return records;
+  }
+} // namespace
+
+void AccessLog::writeRecordsTest() {
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = directory.filePath("access.log");
+
+  {
+    test::api::MockApiServer apiServer{
+      test::api::MockApiServer::State::Normal,
+      test::api::MockApiServer::Options{ .accessLogPath = path }
+    };
+    // Login request is sent, so it is logged as well
+    test::utils::tokenCache().invalidate("superuser");
+    auto token = test::utils::loginUser(apiServer.url(), "superuser");
+    test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+    test::utils::makeGetRequest(makeGetByIdRequest(apiServer, ""));
+    // Records are written when API Mock is destroyed at the latest
+  }
+
+  auto records = readRecords(path);
+  QCOMPARE(records.size(), 3);
+
+  auto login = records[0];
+  QCOMPARE(login["method"].toString(), "GET");
+  QCOMPARE(login["route"].toString(), "/login/<arg>");
+
+  auto served = records[1];
+  QCOMPARE(served["method"].toString(), "GET");
+  QCOMPARE(served["route"].toString(), "/cable/type/id/<arg>");
+  QCOMPARE(served["role"].toString(), "superuser");
+  QCOMPARE(served["state"].toString(), "Normal");
+  QCOMPARE(served["status"].toInt(), 200);
+  QCOMPARE(served["bytesIn"].toInt(), 0);
+  QVERIFY(served["bytesOut"].toInt() > 0);
+  QVERIFY(served["serverTimeUs"].toInteger() >= 0);
+  QVERIFY(not served["time"].toString().isEmpty());
+
+  auto rejected = records[2];
+  QCOMPARE(rejected["role"].toString(), "anonymous");
+  QCOMPARE(rejected["status"].toInt(), 401);
+}
+
+QTEST_MAIN(AccessLog)
+#include "AccessLog.moc"
@@ -0,0 +1,231 @@
+#include <CableTypeStore.h>
+#include <IdentifierIndex.h>
+#include <MockApiServer.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+#include <QUrlQuery>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utils.h>
+
+class Autocomplete : public QObject {
+  Q_OBJECT
+
+private slots:
+  void autocompleteTest_data();
+  void autocompleteTest();
+
+  void completionsMatchBruteForceTest();
+  void completionsFollowWritesTest();
+};
+
+namespace {
+  QJsonObject makeCableType(int index,
+                            const QString& identifier,
+                            const QString& customerCode) {
+    auto cableType = test::utils::makeCableType(index, customerCode);
+    cableType["identifier"] = identifier;
+    return cableType;
+  }
+
+  /*
+   * Whether prefix of identifier is at most one insertion, deletion,
+   * replacement or swap of adjacent characters away from typed one.
+   */
+  bool isTypoOf(const QString& identifier, const QString& typed) {
+    for (auto length = std::max<qsizetype>(1, typed.size() - 1);
+         length <= std::min(typed.size() + 1, identifier.size());
+         ++length) {
+      auto prefix = identifier.left(length);
+      if (prefix.size() == typed.size()) {
+        std::vector<qsizetype> differences;
+        for (qsizetype i = 0; i < prefix.size(); ++i) {
+          if (prefix[i] != typed[i]) {
+            differences.push_back(i);
+          }
+        }
+        if (differences.size() <= 1 or
+            (2 == differences.size() and
+             differences[0] + 1 == differences[1] and
+             prefix[differences[0]] == typed[differences[1]] and
+             prefix[differences[1]] == typed[differences[0]])) {
+          return true;
+        }
+        continue;
+      }
+
+      const auto& shorter = prefix.size() < typed.size() ? prefix : typed;
+      const auto& longer = prefix.size() < typed.size() ? typed : prefix;
+      for (qsizetype i = 0; i < longer.size(); ++i) {
+        if (QString(longer).remove(i, 1) == shorter) {
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  std::vector<QString> completeByBruteForce(const std::set<QString>& stored,
+                                            const QString& prefix,
+                                            std::size_t limit,
+                                            bool typos) {
+    std::vector<QString> completions;
+    std::vector<QString> found;
+    for (const auto& identifier : stored) {
+      if (identifier.startsWith(prefix)) {
+        completions.push_back(identifier);
+      } else if (typos and isTypoOf(identifier, prefix)) {
+        found.push_back(identifier);
+      }
+    }
+    completions.insert(completions.end(), found.begin(), found.end());
+    completions.resize(std::min(limit, completions.size()));
+    return completions;
+  }
+
+  QStringList listOf(const std::vector<QString>& identifiers) {
+    return QStringList(identifiers.begin(), identifiers.end());
+  }
+} // namespace
+
+void Autocomplete::autocompleteTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<QString>("query");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<QStringList>("expectedIdentifiers");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+
+  QTest::newRow("User completes prefix, identifiers starting with it "
+                "returned in response and response code 200")
+      << "user" << "prefix=10-al" << 200
+      << QStringList{ "10-al-1c-trxple", "10-al-3c-trxple", "10-al-3c-xlpe" }
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Superuser completes prefix up to limit, first identifiers "
+                "returned in response and response code 200")
+      << "superuser" << "prefix=10-al&limit=2" << 200
+      << QStringList{ "10-al-1c-trxple", "10-al-3c-trxple" }
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("User completes prefix with typo, no identifiers returned "
+                "in response and response code 200")
+      << "user" << "prefix=10-la" << 200 << QStringList{}
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("User completes prefix with typo tolerating typos, "
+                "identifiers returned in response and response code 200")
+      << "user" << "prefix=10-la&typos=true" << 200
+      << QStringList{ "10-al-1c-trxple", "10-al-3c-trxple", "10-al-3c-xlpe" }
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("User completes prefix tolerating typos, identifiers "
+                "starting with prefix returned first and response code 200")
+      << "user" << "prefix=10-cu&typos=true" << 200
+      << QStringList{ "10-cu-1c-trxple", "1-cu-1c-pvc" }
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("No token provided in request, error message with response "
+                "code 401 returned (no permissions)")
+      << "" << "prefix=10-al" << 401 << QStringList{}
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Request with invalid limit, error message with response "
+                "code 400 returned")
+      << "user" << "prefix=10-al&limit=0" << 400 << QStringList{}
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "user" << "prefix=10-al" << 500 << QStringList{}
+      << test::api::MockApiServer::State::DatabaseConnectionError;
+}
+
+void Autocomplete::autocompleteTest() {
+  QFETCH(QString, userRole);
+  QFETCH(QString, query);
+  QFETCH(int, expectedResultCode);
+  QFETCH(QStringList, expectedIdentifiers);
+  QFETCH(test::api::MockApiServer::State, apiState);
+
+  // Default cable type is 10-al-1c-trxple of bge
+  test::api::MockApiServer apiServer{ apiState };
+  auto& store = apiServer.store();
+  store.create(makeCableType(1, "10-al-3c-xlpe", "bge"));
+  store.create(makeCableType(2, "10-al-3c-trxple", "bge"));
+  store.create(makeCableType(3, "10-al-3c-trxple", "abc"));
+  store.create(makeCableType(4, "10-cu-1c-trxple", "bge"));
+  store.create(makeCableType(5, "1-cu-1c-pvc", "bge"));
+  store.create(makeCableType(6, "20-al-1c-trxple", "bge"));
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(apiServer.url("/cable/type/autocomplete"),
+                                   token,
+                                   QUrlQuery(query)));
+  QCOMPARE(returnCode, expectedResultCode);
+  if (200 != expectedResultCode) {
+    return;
+  }
+
+  QCOMPARE(responseObject["identifiers"].toArray(),
+           QJsonArray::fromStringList(expectedIdentifiers));
+}
+
+void Autocomplete::completionsMatchBruteForceTest() {
+  std::mt19937 random{ 17 };
+  auto randomString = [&random](qsizetype maxLength) {
+    static const QString alphabet{ "abc-1" };
+    QString string;
+    for (auto length = random() % (maxLength + 1); length > 0; --length) {
+      string += alphabet[random() % alphabet.size()];
+    }
+    return string;
+  };
+
+  for (int round = 0; round < 200; ++round) {
+    test::api::IdentifierIndex index;
+    std::set<QString> stored;
+    for (int i = 0; i < 100; ++i) {
+      auto identifier = randomString(6);
+      index.add(identifier);
+      if (not identifier.isEmpty()) {
+        stored.insert(identifier);
+      }
+    }
+    QCOMPARE(index.size(), stored.size());
+
+    for (int i = 0; i < 20; ++i) {
+      auto prefix = randomString(4);
+      auto limit = 1 + random() % 15;
+      auto typos = 0 == random() % 2;
+      QCOMPARE(listOf(index.complete(prefix, limit, typos)),
+               listOf(completeByBruteForce(stored, prefix, limit, typos)));
+    }
+  }
+}
+
+void Autocomplete::completionsFollowWritesTest() {
+  test::api::CableTypeStore store;
+  auto bge = store.create(makeCableType(1, "10-al-3c-xlpe", "bge"));
+  auto abc = store.create(makeCableType(2, "10-al-3c-xlpe", "abc"));
+  store.create(makeCableType(3, "10-al-1c-trxple", "bge"));
+
+  // Identifier shared by cable types is completed once
+  QCOMPARE(listOf(store.completeIdentifier("10-al-3", 10, false)),
+           QStringList{ "10-al-3c-xlpe" });
+
+  QVERIFY(store.remove(bge));
+  QCOMPARE(listOf(store.completeIdentifier("10-al-3", 10, false)),
+           QStringList{ "10-al-3c-xlpe" });
+  QVERIFY(store.remove(abc));
+  QVERIFY(store.completeIdentifier("10-al-3", 10, false).empty());
+  QCOMPARE(listOf(store.completeIdentifier("", 10, false)),
+           QStringList{ "10-al-1c-trxple" });
+}
+
+QTEST_MAIN(Autocomplete)
+#include "Autocomplete.moc"
@@ -0,0 +1,216 @@
+#include <CableType.h>
+#include <CableTypeColumns.h>
+#include <CableTypeStore.h>
+#include <DefaultCableType.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <span>
+#include <utils.h>
+
+class CableTypeModel : public QObject {
+  Q_OBJECT
+
+private slots:
+  void jsonRoundTripTest();
+  void missingFieldsTest();
+  void numericFieldPathTest();
+
+  void columnsFollowStoreTest();
+  void removeMovesLastRowTest();
+  void stringsInternedTest();
+  void stringsReleasedTest();
+};
+
+namespace {
+  using test::api::CableType;
+  using test::api::CableTypeColumns;
+  using test::api::CableTypeStore;
+  using test::api::NumericField;
+
+  QJsonObject defaultCableType() {
+    return QJsonDocument::fromJson(test::api::defaultCableTypeData).object();
+  }
+
+  QJsonObject makeCableType(int index, double price) {
+    auto cableType = test::utils::makeCableType(index);
+    cableType["id"] = QString("%1").arg(index, 24, 10, QChar('0'));
+    cableType["currentPrice"] =
+        QJsonObject{ { "value", price }, { "unit", "USD" } };
+    return cableType;
+  }
+
+  /*
+   * Row of each id in columns, checks that every row is someone's.
+   */
+  std::map<QString, CableTypeColumns::Row>
+  rowsOf(const CableTypeStore& store) {
+    return store.scan([](const CableTypeColumns& columns,
+                         std::span<const CableTypeStore::Entry> entries) {
+      std::map<QString, CableTypeColumns::Row> rows;
+      for (CableTypeColumns::Row row = 0; row < columns.size(); ++row) {
+        rows[columns.id(row)] = row;
+        // Stored cable type and columns of row are the same one
+        if (entries[row]->cableType()["id"].toString() != columns.id(row)) {
+          return std::map<QString, CableTypeColumns::Row>{};
+        }
+      }
+      return rows;
+    });
+  }
+
+  double priceOf(const CableTypeStore& store, const QString& id) {
+    return store.scan([&id](const CableTypeColumns& columns, auto) {
+      for (CableTypeColumns::Row row = 0; row < columns.size(); ++row) {
+        if (columns.id(row) == id) {
+          return columns.values(NumericField::CurrentPrice)[row];
+        }
+      }
+      return std::numeric_limits<double>::quiet_NaN();
+    });
+  }
+} // namespace
+
+void CableTypeModel::jsonRoundTripTest() {
+  auto document = defaultCableType();
+  auto cableType = CableType::fromJson(document);
+
+  QCOMPARE(cableType.id, "5f3bc9e2502422053e08f9f1");
+  QCOMPARE(cableType.catid, 1622475);
+  QVERIFY(cableType.measure(NumericField::CurrentPrice).has_value());
+  QCOMPARE(cableType.measure(NumericField::CurrentPrice)->value, 22.43);
+  QCOMPARE(cableType.measure(NumericField::CurrentPrice)->unit, "USD");
+  QCOMPARE(cableType.conductorNumber.value_or(-1), 0);
+  QCOMPARE(cableType.manufacturerName, "Kerite");
+  QCOMPARE(cableType.properties.size(), std::size_t{ 1 });
+  QCOMPARE(cableType.properties.front().name, "manufacturedBy");
+  QCOMPARE(cableType.customerCode, "bge");
+  QCOMPARE(cableType.toJson(), document);
+}
+
+void CableTypeModel::missingFieldsTest() {
+  QJsonObject document{ { "id", "1" },
+                        { "identifier", "1-al-1c-trxple" },
+                        { "catid", 1 },
+                        { "voltage", QJsonObject{ { "unit", "V" } } } };
+  auto cableType = CableType::fromJson(document);
+
+  QVERIFY(not cableType.measure(NumericField::CurrentPrice).has_value());
+  QVERIFY(std::isnan(cableType.measure(NumericField::Voltage)->value));
+  QVERIFY(not cableType.conductorNumber.has_value());
+  QVERIFY(cableType.manufacturerId.isEmpty());
+  QCOMPARE(cableType.toJson(), document);
+}
+
+void CableTypeModel::numericFieldPathTest() {
+  for (auto field : test::api::numericFields) {
+    QVERIFY(test::api::numericFieldOf(test::api::pathOf(field)) == field);
+  }
+  QCOMPARE(test::api::pathOf(NumericField::NetWeight),
+           "material.weight.net");
+  QVERIFY(not test::api::numericFieldOf("material.weight").has_value());
+}
+
+void CableTypeModel::columnsFollowStoreTest() {
+  CableTypeStore store;
+  QVERIFY(store.insert(makeCableType(0, 10)));
+  auto id = store.create(makeCableType(1, 20));
+
+  QCOMPARE(priceOf(store, id), 20.0);
+  QVERIFY(store.replace(id, makeCableType(1, 30)));
+  QCOMPARE(priceOf(store, id), 30.0);
+
+  auto cableType = makeCableType(2, 0);
+  cableType.remove("currentPrice");
+  auto withoutPrice = store.create(cableType);
+  QVERIFY(std::isnan(priceOf(store, withoutPrice)));
+  QCOMPARE(rowsOf(store).size(), std::size_t{ 3 });
+}
+
+void CableTypeModel::removeMovesLastRowTest() {
+  CableTypeStore store;
+  for (int i = 0; i < 5; ++i) {
+    QVERIFY(store.insert(makeCableType(i, i)));
+  }
+  auto first = makeCableType(0, 0)["id"].toString();
+  auto last = makeCableType(4, 4)["id"].toString();
+
+  QVERIFY(store.remove(first));
+  auto rows = rowsOf(store);
+  QCOMPARE(rows.size(), std::size_t{ 4 });
+  QCOMPARE(rows.at(last), std::size_t{ 0 });
+  QCOMPARE(priceOf(store, last), 4.0);
+  QCOMPARE(store.findById(last)->cableType()["catid"].toInt(), 1000004);
+
+  // Removing last row moves nothing
+  QVERIFY(store.remove(makeCableType(3, 3)["id"].toString()));
+  QCOMPARE(rowsOf(store).size(), std::size_t{ 3 });
+  QVERIFY(not store.findById(first));
+  QCOMPARE(store.findByCatId(3000004)->cableType()["id"].toString(), last);
+}
+
+void CableTypeModel::stringsInternedTest() {
+  CableTypeStore store;
+  for (int i = 0; i < 10; ++i) {
+    QVERIFY(store.insert(makeCableType(i, i)));
+  }
+
+  store.scan([](const CableTypeColumns& columns, auto) {
+    const auto& strings = columns.strings();
+    // Empty string, units, manufacturer id and name, customer code
+    QCOMPARE(strings.size(), std::size_t{ 7 });
+    auto kerite = strings.find("Kerite");
+    QVERIFY(kerite.has_value());
+    for (auto name : columns.manufacturerNames()) {
+      QCOMPARE(name, *kerite);
+    }
+    QCOMPARE(strings.at(columns.units(NumericField::CurrentPrice)[0]),
+             "USD");
+  });
+}
+
+void CableTypeModel::stringsReleasedTest() {
+  CableTypeStore store;
+  auto stringCount = [&store] {
+    return store.scan([](const CableTypeColumns& columns, auto) {
+      return columns.strings().size();
+    });
+  };
+  auto withCustomer = [](int index, const QString& code) {
+    auto cableType = makeCableType(index, 1.0);
+    cableType["customer"] = QJsonObject{ { "id", code }, { "code", code } };
+    return cableType;
+  };
+
+  QVERIFY(store.insert(withCustomer(0, "customer-0")));
+  auto initialCount = stringCount();
+
+  // Customers come and go, ids of released strings are reused
+  for (int i = 1; i <= 1000; ++i) {
+    auto id = QString("%1").arg(i, 24, 10, QChar('0'));
+    QVERIFY(store.insert(withCustomer(i, QString("customer-%1").arg(i))));
+    QVERIFY(store.replace(
+        id, withCustomer(i, QString("replaced-customer-%1").arg(i))));
+    QVERIFY(store.remove(id));
+  }
+  QVERIFY(stringCount() <= initialCount + 2);
+
+  store.scan([](const CableTypeColumns& columns, auto) {
+    const auto& strings = columns.strings();
+    QVERIFY(not strings.find("customer-1000").has_value());
+    QVERIFY(not strings.find("replaced-customer-1000").has_value());
+    // Strings of remaining cable type are kept
+    auto code = strings.find("customer-0");
+    QVERIFY(code.has_value());
+    QCOMPARE(columns.customerCodes()[0], *code);
+    QCOMPARE(strings.at(columns.units(NumericField::CurrentPrice)[0]),
+             "USD");
+  });
+}
+
+QTEST_MAIN(CableTypeModel)
+#include "CableTypeModel.moc"
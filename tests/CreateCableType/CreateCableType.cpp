@@ -1,8 +1,11 @@
 #include <MockApiServer.h>
+#include <QEventLoop>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
+#include <QTcpSocket>
 #include <QTest>
+#include <QTimer>
 #include <utils.h>
 
 class CreateCableType : public QObject {
@@ -11,6 +14,11 @@ class CreateCableType : public QObject {
 private slots:
   void createCableTypeTest_data();
   void createCableTypeTest();
+  void payloadExceedingLimitTest();
+  void chunkedPayloadExceedingLimitTest();
+  void pipelinedPayloadsWithinLimitTest();
+  void pipelinedPayloadExceedingLimitTest();
+  void existingIdentifierAndCustomerCodeTest();
 };
 
 namespace {
@@ -173,6 +181,51 @@ namespace {
         } 
       } 
     })";
+
+  /*
+   * Head of cable type creating request, framing header tells
+   * how body follows, e.g. "Transfer-Encoding: chunked".
+   */
+  QByteArray createRequestHead(const QUrl& url,
+                               const QString& token,
+                               const QByteArray& framing) {
+    return "POST /cable/type HTTP/1.1\r\n"
+           "Host: " +
+           url.authority().toUtf8() +
+           "\r\n"
+           "Authorization: " +
+           token.toUtf8() +
+           "\r\n"
+           "Content-Type: application/json\r\n" +
+           framing + "\r\n\r\n";
+  }
+
+  /*
+   * Writes raw requests on new connection, so their framing is exactly
+   * as written, and returns what is responded until responseCount
+   * responses start or connection is closed.
+   */
+  QByteArray exchange(const QUrl& url,
+                      const QByteArray& requests,
+                      qsizetype responseCount) {
+    QTcpSocket socket;
+    QByteArray responses;
+    QEventLoop loop;
+    QObject::connect(&socket, &QTcpSocket::readyRead, &loop, [&] {
+      responses += socket.readAll();
+      if (responses.count("HTTP/1.1 ") >= responseCount) {
+        loop.quit();
+      }
+    });
+    QObject::connect(
+        &socket, &QTcpSocket::disconnected, &loop, &QEventLoop::quit);
+    QTimer::singleShot(5000, &loop, &QEventLoop::quit);
+
+    socket.connectToHost(url.host(), static_cast<quint16>(url.port()));
+    socket.write(requests);
+    loop.exec();
+    return responses + socket.readAll();
+  }
 } // namespace
 
 void CreateCableType::createCableTypeTest_data() {
@@ -334,13 +387,13 @@ void CreateCableType::createCableTypeTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
-  QNetworkRequest request(QUrl(QString("http://localhost:8080/cable/type")));
+  QNetworkRequest request(apiServer.url("/cable/type"));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
@@ -355,5 +408,141 @@ void CreateCableType::createCableTypeTest() {
   QCOMPARE(networkError, expectedNetworkError);
 }
 
+void CreateCableType::payloadExceedingLimitTest() {
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .maxBodySize = 4096 }
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  auto requestBody = QJsonDocument::fromJson(requestBodyRaw).object();
+  requestBody["comment"] = QString(8192, 'x');
+
+  QNetworkRequest request(apiServer.url("/cable/type"));
+  request.setRawHeader("Authorization", token.toLocal8Bit());
+  request.setHeader(QNetworkRequest::ContentTypeHeader,
+                    QString("application/json"));
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makePostRequest(request,
+                                   QJsonDocument(requestBody).toJson());
+
+  QCOMPARE(responseObject,
+           QJsonDocument::fromJson(R"({"cause": "Payload exceeds size limit"})")
+               .object());
+  QCOMPARE(returnCode, 413);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::UnknownContentError);
+  QVERIFY(not apiServer.store()
+                  .findByIdentifier("10-al-1c-trxple")
+                  ->cableType()
+                  .contains("comment"));
+}
+
+void CreateCableType::chunkedPayloadExceedingLimitTest() {
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .maxBodySize = 4096 }
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  // Chunks declare no size up front, so it is their total that is limited
+  auto request = createRequestHead(
+      apiServer.url(), token, "Transfer-Encoding: chunked");
+  for (int i = 0; i < 8; ++i) {
+    request += "400\r\n" + QByteArray(1024, 'x') + "\r\n";
+  }
+  request += "0\r\n\r\n";
+  auto response = exchange(apiServer.url(), request, 1);
+
+  QVERIFY2(response.startsWith("HTTP/1.1 413"), response.constData());
+  QCOMPARE(QJsonDocument::fromJson(
+               response.mid(response.indexOf("\r\n\r\n") + 4))
+               .object(),
+           QJsonDocument::fromJson(R"({"cause": "Payload exceeds size limit"})")
+               .object());
+  QCOMPARE(apiServer.store().size(), std::size_t{ 1 });
+}
+
+void CreateCableType::pipelinedPayloadsWithinLimitTest() {
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .maxBodySize = 4096 }
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  // Each body is within limit, both of them together are not
+  QByteArray requests;
+  for (const auto* identifier : { "11-al-1c-trxple", "12-al-1c-trxple" }) {
+    auto cableType = QJsonDocument::fromJson(requestBodyRaw).object();
+    cableType["identifier"] = identifier;
+    cableType["comment"] = QString(2500, 'x');
+    auto body = QJsonDocument(cableType).toJson(QJsonDocument::Compact);
+    QVERIFY(body.size() < 4096);
+    requests += createRequestHead(
+                    apiServer.url(),
+                    token,
+                    "Content-Length: " + QByteArray::number(body.size())) +
+                body;
+  }
+  auto responses = exchange(apiServer.url(), requests, 2);
+
+  QCOMPARE(responses.count("HTTP/1.1 200"), qsizetype{ 2 });
+  QVERIFY(apiServer.store().findByIdentifier("11-al-1c-trxple"));
+  QVERIFY(apiServer.store().findByIdentifier("12-al-1c-trxple"));
+}
+
+void CreateCableType::pipelinedPayloadExceedingLimitTest() {
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .maxBodySize = 4096 }
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  // Request preceding rejected one in the same write is still served
+  auto cableType = QJsonDocument::fromJson(requestBodyRaw).object();
+  cableType["identifier"] = "11-al-1c-trxple";
+  auto body = QJsonDocument(cableType).toJson(QJsonDocument::Compact);
+  auto oversized = QByteArray(8192, 'x');
+  auto requests =
+      createRequestHead(apiServer.url(),
+                        token,
+                        "Content-Length: " + QByteArray::number(body.size())) +
+      body +
+      createRequestHead(
+          apiServer.url(),
+          token,
+          "Content-Length: " + QByteArray::number(oversized.size())) +
+      oversized;
+  auto responses = exchange(apiServer.url(), requests, 2);
+
+  auto served = responses.indexOf("HTTP/1.1 200");
+  auto rejected = responses.indexOf("HTTP/1.1 413");
+  QVERIFY2(served >= 0 and rejected > served, responses.constData());
+  QVERIFY(apiServer.store().findByIdentifier("11-al-1c-trxple"));
+}
+
+void CreateCableType::existingIdentifierAndCustomerCodeTest() {
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  // Request body has identifier and customer code of default cable type,
+  // which is upserted rather than answered with conflict in normal state
+  auto requestBody = QJsonDocument::fromJson(requestBodyRaw).object();
+  requestBody["comment"] = "posted again";
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makePostRequest(
+          test::utils::makeRequest(apiServer.url("/cable/type"), token),
+          QJsonDocument(requestBody).toJson());
+
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(responseObject["id"].toString(),
+           QString("5f3bc9e2502422053e08f9f1"));
+  QCOMPARE(apiServer.store().size(), std::size_t{ 1 });
+  QCOMPARE(apiServer.store()
+               .findById("5f3bc9e2502422053e08f9f1")
+               ->cableType()["comment"]
+               .toString(),
+           QString("posted again"));
+}
+
 QTEST_MAIN(CreateCableType)
 #include "CreateCableType.moc"
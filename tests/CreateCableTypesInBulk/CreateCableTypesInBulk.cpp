@@ -0,0 +1,143 @@
+#include <MockApiServer.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+#include <utils.h>
+
+class CreateCableTypesInBulk : public QObject {
+  Q_OBJECT
+
+private slots:
+  void createCableTypesInBulkTest_data();
+  void createCableTypesInBulkTest();
+};
+
+namespace {
+  static constexpr char requestBodyRaw[] = R"(
+    {
+      "identifier": "20-cu-3c-trxple",
+      "catid": 1622476,
+      "rotationFrequency": {
+        "value": 22.43,
+        "unit": "m"
+      },
+      "manufacturer": {
+        "id": "5f3bc9e2502422053e08f9f1",
+        "name": "Kerite"
+      },
+      "customer": {
+        "id": "5f3bc9e2502422053e08f9f1",
+        "code": "bge"
+      }
+  })";
+} // namespace
+
+void CreateCableTypesInBulk::createCableTypesInBulkTest_data() {
+
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<QList<QJsonObject>>("requestLines");
+  QTest::addColumn<QList<QJsonObject>>("expectedResponseLines");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<QNetworkReply::NetworkError>("expectedNetworkError");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+  QTest::addColumn<int>("expectedStoreSize");
+
+  auto validCableType = QJsonDocument::fromJson(requestBodyRaw).object();
+
+  auto cableTypeWithId = validCableType;
+  cableTypeWithId["id"] = "5f3bc9e2502422053e08f9f1";
+
+  auto cableTypeWithoutRequiredKeys = validCableType;
+  cableTypeWithoutRequiredKeys.remove("identifier");
+
+  auto cableTypeWithInvalidRotationFrequencyUnit = validCableType;
+  cableTypeWithInvalidRotationFrequencyUnit["rotationFrequency"] =
+      QJsonObject{ { "value", 22.43 }, { "unit", "g" } };
+
+  auto existingCableType = validCableType;
+  existingCableType["identifier"] = "10-al-1c-trxple";
+  existingCableType["catid"] = 1622475;
+
+  QList<QJsonObject> requestLines{ validCableType,
+                                   cableTypeWithId,
+                                   cableTypeWithoutRequiredKeys,
+                                   cableTypeWithInvalidRotationFrequencyUnit,
+                                   existingCableType };
+
+  QList<QJsonObject> lineResults{
+    QJsonObject{ { "line", 1 }, { "id", "000000000000000000000001" } },
+    QJsonObject{ { "line", 2 }, { "cause", "id provided in request" } },
+    QJsonObject{ { "line", 3 }, { "cause", "missing required keys" } },
+    QJsonObject{ { "line", 4 },
+                { "cause", "rotationFrequency.unit has invalid value" } },
+    QJsonObject{ { "line", 5 }, { "id", "5f3bc9e2502422053e08f9f1" } }
+  };
+
+  QList<QJsonObject> unauthorized{ QJsonDocument::fromJson(
+                                       R"({"cause": "Unauthorized"})")
+                                       .object() };
+
+  QTest::newRow("Superuser sends cable types, created id or error cause "
+                "returned for every line and response code 200")
+      << "superuser" << requestLines << lineResults << 200
+      << QNetworkReply::NetworkError::NoError
+      << test::api::MockApiServer::State::Normal << 2;
+
+  QTest::newRow("Admin sends cable types, created id or error cause returned "
+                "for every line and response code 200")
+      << "admin" << requestLines << lineResults << 200
+      << QNetworkReply::NetworkError::NoError
+      << test::api::MockApiServer::State::Normal << 2;
+
+  QTest::newRow("User sends cable types, error message with response code 401 "
+                "returned (no permissions)")
+      << "user" << requestLines << unauthorized << 401
+      << QNetworkReply::NetworkError::AuthenticationRequiredError
+      << test::api::MockApiServer::State::Normal << 1;
+
+  QTest::newRow("No token provided in request, error message with response "
+                "code 401 returned (no permissions)")
+      << "" << requestLines << unauthorized << 401
+      << QNetworkReply::NetworkError::AuthenticationRequiredError
+      << test::api::MockApiServer::State::Normal << 1;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "admin" << requestLines
+      << QList<QJsonObject>{ QJsonDocument::fromJson(
+                                 R"({"cause": "Database connection error"})")
+                                 .object() }
+      << 500 << QNetworkReply::NetworkError::InternalServerError
+      << test::api::MockApiServer::State::DatabaseConnectionError << 1;
+}
+
+void CreateCableTypesInBulk::createCableTypesInBulkTest() {
+  QFETCH(QString, userRole);
+  QFETCH(QList<QJsonObject>, requestLines);
+  QFETCH(QList<QJsonObject>, expectedResponseLines);
+  QFETCH(int, expectedResultCode);
+  QFETCH(QNetworkReply::NetworkError, expectedNetworkError);
+  QFETCH(test::api::MockApiServer::State, apiState);
+  QFETCH(int, expectedStoreSize);
+
+  test::api::MockApiServer apiServer{ apiState };
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  QNetworkRequest request(apiServer.url("/cable/type/bulk"));
+  if (not userRole.isEmpty()) {
+    request.setRawHeader("Authorization", token.toLocal8Bit());
+  }
+  request.setHeader(QNetworkRequest::ContentTypeHeader,
+                    QString("application/x-ndjson"));
+  auto [responseLines, returnCode, networkError] =
+      test::utils::makeNdjsonPostRequest(request, requestLines);
+
+  QCOMPARE(responseLines, expectedResponseLines);
+  QCOMPARE(returnCode, expectedResultCode);
+  QCOMPARE(networkError, expectedNetworkError);
+  QCOMPARE(apiServer.store().size(), std::size_t(expectedStoreSize));
+}
+
+QTEST_MAIN(CreateCableTypesInBulk)
+#include "CreateCableTypesInBulk.moc"
@@ -130,14 +130,14 @@ void DeleteCableType::deleteCableTypeTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
   QNetworkRequest request(
-      QUrl(QString("http://localhost:8080/cable/type/id/%1").arg(testId)));
+      apiServer.url(QString("/cable/type/id/%1").arg(testId)));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
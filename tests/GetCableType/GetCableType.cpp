@@ -1,4 +1,5 @@
 #include <MockApiServer.h>
+#include <QEventLoop>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QObject>
@@ -23,6 +24,12 @@ private slots:
 
   void getCableTypeByCatIdAndCustomerCodeTest_data();
   void getCableTypeByCatIdAndCustomerCodeTest();
+
+  void getCompressedCableTypeTest_data();
+  void getCompressedCableTypeTest();
+
+  void getCableTypeIfNoneMatchTest_data();
+  void getCableTypeIfNoneMatchTest();
 };
 
 namespace {
@@ -230,14 +237,14 @@ void GetCableType::getCableTypeByIdTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
   QNetworkRequest request(
-      QUrl(QString("http://localhost:8080/cable/type/id/%1").arg(testId)));
+      apiServer.url(QString("/cable/type/id/%1").arg(testId)));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
@@ -340,15 +347,14 @@ void GetCableType::getCableTypeByIdentifierTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
   QNetworkRequest request(
-      QUrl(QString("http://localhost:8080/cable/type/identifier/%1")
-               .arg(testIdentifier)));
+      apiServer.url(QString("/cable/type/identifier/%1").arg(testIdentifier)));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
@@ -451,14 +457,14 @@ void GetCableType::getCableTypeByCatIdTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
   QNetworkRequest request(
-      QUrl(QString("http://localhost:8080/cable/type/catid/%1").arg(catid)));
+      apiServer.url(QString("/cable/type/catid/%1").arg(catid)));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
@@ -577,14 +583,14 @@ void GetCableType::getCableTypeByIdentifierAndCustomerCodeTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
-  QNetworkRequest request(QUrl(
-      QString("http://localhost:8080/cable/type/identifier/%1/customer/code/%2")
+  QNetworkRequest request(apiServer.url(
+      QString("/cable/type/identifier/%1/customer/code/%2")
           .arg(testIdentifier)
           .arg(testCustomerCode)));
   if (not userRole.isEmpty()) {
@@ -705,16 +711,16 @@ void GetCableType::getCableTypeByCatIdAndCustomerCodeTest() {
   QFETCH(test::api::MockApiServer::State, apiState);
 
   test::api::MockApiServer apiServer{ apiState };
-  auto token = test::utils::loginUser(userRole);
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
 
   if (not userRole.isEmpty()) {
     QCOMPARE(155ul, token.size());
   }
 
   QNetworkRequest request(
-      QUrl(QString("http://localhost:8080/cable/type/catid/%1/customer/code/%2")
-               .arg(catid)
-               .arg(testCustomerCode)));
+      apiServer.url(QString("/cable/type/catid/%1/customer/code/%2")
+                        .arg(catid)
+                        .arg(testCustomerCode)));
   if (not userRole.isEmpty()) {
     request.setRawHeader("Authorization", token.toLocal8Bit());
   }
@@ -728,5 +734,139 @@ void GetCableType::getCableTypeByCatIdAndCustomerCodeTest() {
   QCOMPARE(networkError, expectedNetworkError);
 }
 
+void GetCableType::getCompressedCableTypeTest_data() {
+  QTest::addColumn<QByteArray>("acceptEncoding");
+  QTest::addColumn<QByteArray>("expectedEncoding");
+
+  QTest::newRow("Both codings accepted, gzip preferred")
+      << QByteArray("gzip, deflate") << QByteArray("gzip");
+  QTest::newRow("Only deflate accepted")
+      << QByteArray("deflate") << QByteArray("deflate");
+  QTest::newRow("Coding of higher quality picked")
+      << QByteArray("gzip;q=0.1, deflate;q=1") << QByteArray("deflate");
+  QTest::newRow("Codings of the same quality, gzip preferred")
+      << QByteArray("deflate;q=0.5, gzip;q=0.5") << QByteArray("gzip");
+  QTest::newRow("Wildcard accepts gzip")
+      << QByteArray("*") << QByteArray("gzip");
+  QTest::newRow("Wildcard of higher quality than listed coding")
+      << QByteArray("deflate;q=0.5, *;q=0.8") << QByteArray("gzip");
+  QTest::newRow("Wildcard refused, listed coding picked")
+      << QByteArray("*;q=0, deflate") << QByteArray("deflate");
+  QTest::newRow("Identity preferred over codings")
+      << QByteArray("gzip;q=0.5, identity") << QByteArray();
+  QTest::newRow("Only coding refused") << QByteArray("gzip;q=0")
+                                       << QByteArray();
+}
+
+void GetCableType::getCompressedCableTypeTest() {
+  QFETCH(QByteArray, acceptEncoding);
+  QFETCH(QByteArray, expectedEncoding);
+
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  QNetworkRequest request(
+      apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1"));
+  request.setRawHeader("Authorization", token.toLocal8Bit());
+  request.setHeader(QNetworkRequest::ContentTypeHeader,
+                    QString("application/json"));
+
+  test::utils::Client compressingClient;
+  test::utils::Client plainClient{ test::utils::Client::Options{
+      .compression = false } };
+
+  auto validResponseBody = QJsonDocument::fromJson(responseBodyRaw).object();
+  auto [compressedObject, compressedReturnCode, compressedNetworkError] =
+      test::utils::makeGetRequest(compressingClient, request);
+  auto [plainObject, plainReturnCode, plainNetworkError] =
+      test::utils::makeGetRequest(plainClient, request);
+
+  QCOMPARE(compressedObject, validResponseBody);
+  QCOMPARE(compressedReturnCode, 200);
+  QCOMPARE(plainObject, validResponseBody);
+  QCOMPARE(plainReturnCode, 200);
+  QVERIFY(compressingClient.bodyBytesReceived() <
+          plainClient.bodyBytesReceived());
+
+  // Qt leaves body as is for Accept-Encoding set by request
+  auto negotiatedRequest = request;
+  negotiatedRequest.setRawHeader("Accept-Encoding", acceptEncoding);
+  auto* reply = plainClient.manager().get(negotiatedRequest);
+  QEventLoop loop;
+  QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+  loop.exec();
+  QCOMPARE(reply->rawHeader("Content-Encoding"), expectedEncoding);
+  reply->deleteLater();
+
+  // Compressed form of replaced cable type must not be reused
+  auto updatedCableType = validResponseBody;
+  updatedCableType["voltage"] = QJsonObject{
+    { "value", 11.2 },
+    { "unit", "kV" }
+  };
+  apiServer.store().replace("5f3bc9e2502422053e08f9f1", updatedCableType);
+
+  auto [updatedObject, updatedReturnCode, updatedNetworkError] =
+      test::utils::makeGetRequest(compressingClient, request);
+  QCOMPARE(updatedObject, updatedCableType);
+  QCOMPARE(updatedReturnCode, 200);
+}
+
+void GetCableType::getCableTypeIfNoneMatchTest_data() {
+  QTest::addColumn<QString>("path");
+  QTest::addColumn<bool>("currentEtag");
+  QTest::addColumn<QJsonObject>("expectedResponseBody");
+  QTest::addColumn<int>("expectedResultCode");
+
+  auto validResponseBody = QJsonDocument::fromJson(responseBodyRaw).object();
+
+  const QStringList paths{
+    "/cable/type/id/5f3bc9e2502422053e08f9f1",
+    "/cable/type/identifier/10-al-1c-trxple",
+    "/cable/type/catid/1622475",
+    "/cable/type/identifier/10-al-1c-trxple/customer/code/bge",
+    "/cable/type/catid/1622475/customer/code/bge",
+  };
+
+  for (const auto& path : paths) {
+    QTest::addRow("%s with current ETag, empty response with response code "
+                  "304 returned",
+                  qPrintable(path))
+        << path << true << QJsonObject() << 304;
+
+    QTest::addRow("%s with outdated ETag, cable type object returned in "
+                  "response and response code 200",
+                  qPrintable(path))
+        << path << false << validResponseBody << 200;
+  }
+}
+
+void GetCableType::getCableTypeIfNoneMatchTest() {
+  QFETCH(QString, path);
+  QFETCH(bool, currentEtag);
+  QFETCH(QJsonObject, expectedResponseBody);
+  QFETCH(int, expectedResultCode);
+
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  auto etag = currentEtag ? apiServer.store()
+                                .findById("5f3bc9e2502422053e08f9f1")
+                                ->etag(test::api::ContentEncoding::Identity)
+                          : QByteArray(R"("outdated")");
+
+  QNetworkRequest request(apiServer.url(path));
+  request.setRawHeader("Authorization", token.toLocal8Bit());
+  request.setRawHeader("If-None-Match", etag);
+  request.setHeader(QNetworkRequest::ContentTypeHeader,
+                    QString("application/json"));
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(request);
+
+  QCOMPARE(responseObject, expectedResponseBody);
+  QCOMPARE(returnCode, expectedResultCode);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::NoError);
+}
+
 QTEST_MAIN(GetCableType)
 #include "GetCableType.moc"
@@ -0,0 +1,267 @@
+#include <CableTypeStore.h>
+#include <InvertedIndex.h>
+#include <MockApiServer.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+#include <QTest>
+#include <QUrlQuery>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utils.h>
+
+class InvertedIndexes : public QObject {
+  Q_OBJECT
+
+private slots:
+  void postingListTest();
+  void densePostingListTest();
+
+  void findByManufacturerIdTest_data();
+  void findByManufacturerIdTest();
+
+  void findByPropertyNameTest();
+  void indexesFollowWritesTest();
+  void compactionTest();
+};
+
+namespace {
+  QJsonObject makeCableType(int index,
+                            const QString& manufacturerId,
+                            const QStringList& propertyNames) {
+    auto cableType = test::utils::makeCableType(index, "abc");
+    cableType["manufacturer"] =
+        QJsonObject{ { "id", manufacturerId }, { "name", "Kerite" } };
+    QJsonArray properties;
+    for (const auto& name : propertyNames) {
+      properties.append(QJsonObject{ { "name", name }, { "value", index } });
+    }
+    cableType["properties"] = properties;
+    return cableType;
+  }
+
+  QSet<QString> idsOf(const test::api::CableTypeStore::Matches& matches) {
+    return QSet<QString>(matches.ids.begin(), matches.ids.end());
+  }
+} // namespace
+
+void InvertedIndexes::postingListTest() {
+  std::mt19937_64 random{ 11 };
+  test::api::PostingList postings;
+  std::vector<test::api::PostingList::Document> expected;
+  std::size_t discarded = 0;
+
+  for (int i = 0; i < 2000; ++i) {
+    if (0 == random() % 3 and discarded < expected.size()) {
+      postings.discard();
+      ++discarded;
+    } else {
+      // Gaps of one byte and of many bytes when encoded
+      auto previous = expected.empty() ? 0 : expected.back();
+      expected.push_back(previous + 1 +
+                         random() % (0 == random() % 2 ? 3 : 100000));
+      postings.append(expected.back());
+    }
+    QCOMPARE(postings.size(), expected.size() - discarded);
+  }
+
+  // Discarded documents stay encoded until list is rebuilt
+  QVERIFY(postings.documents() == expected);
+  for (; discarded < expected.size(); ++discarded) {
+    QVERIFY(not postings.isEmpty());
+    postings.discard();
+  }
+  QVERIFY(postings.isEmpty());
+}
+
+void InvertedIndexes::densePostingListTest() {
+  test::api::PostingList postings;
+  for (test::api::PostingList::Document document = 1; document <= 100000;
+       ++document) {
+    postings.append(document);
+  }
+
+  // Consecutive documents take a byte each, discarding one shifts none
+  QCOMPARE(postings.bytes(), std::size_t{ 100000 });
+  postings.discard();
+  QCOMPARE(postings.bytes(), std::size_t{ 100000 });
+  QCOMPARE(postings.size(), std::size_t{ 99999 });
+}
+
+void InvertedIndexes::findByManufacturerIdTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<QString>("manufacturerId");
+  QTest::addColumn<QString>("query");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<int>("expectedMatched");
+  QTest::addColumn<int>("expectedReturned");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+
+  QTest::newRow("Superuser gets cable types of manufacturer, ids returned "
+                "in response and response code 200")
+      << "superuser" << "m1" << "" << 200 << 10 << 10
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Superuser gets cable types of manufacturer page by page, "
+                "count of all returned in response and response code 200")
+      << "superuser" << "m1" << "limit=3" << 200 << 10 << 3
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Superuser gets cable types of manufacturer without them, "
+                "empty list returned in response and response code 200")
+      << "superuser" << "m3" << "" << 200 << 0 << 0
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Admin gets cable types of manufacturer, error message with "
+                "response code 401 returned (no permissions)")
+      << "admin" << "m1" << "" << 401 << 0 << 0
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Request with unknown selection, error message with "
+                "response code 400 returned")
+      << "superuser" << "m1" << "select=names" << 400 << 0 << 0
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "superuser" << "m1" << "" << 500 << 0 << 0
+      << test::api::MockApiServer::State::DatabaseConnectionError;
+}
+
+void InvertedIndexes::findByManufacturerIdTest() {
+  QFETCH(QString, userRole);
+  QFETCH(QString, manufacturerId);
+  QFETCH(QString, query);
+  QFETCH(int, expectedResultCode);
+  QFETCH(int, expectedMatched);
+  QFETCH(int, expectedReturned);
+  QFETCH(test::api::MockApiServer::State, apiState);
+
+  test::api::MockApiServer apiServer{ apiState };
+  for (int i = 0; i < 20; ++i) {
+    apiServer.store().create(
+        makeCableType(i, 0 == i % 2 ? "m1" : "m2", { "manufacturedBy" }));
+  }
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(
+              apiServer.url("/cable/type/manufacturer/id/" + manufacturerId),
+              token,
+              QUrlQuery(query)));
+  QCOMPARE(returnCode, expectedResultCode);
+  if (200 != expectedResultCode) {
+    return;
+  }
+
+  QCOMPARE(responseObject["matched"].toInt(), expectedMatched);
+  auto ids = responseObject["ids"].toArray();
+  QCOMPARE(ids.size(), expectedReturned);
+  for (const auto& id : ids) {
+    auto stored = apiServer.store().findById(id.toString());
+    QVERIFY(stored);
+    QCOMPARE(stored->cableType()["manufacturer"]["id"].toString(),
+             manufacturerId);
+  }
+}
+
+void InvertedIndexes::findByPropertyNameTest() {
+  test::api::MockApiServer apiServer;
+  auto& store = apiServer.store();
+  auto both = store.create(makeCableType(1, "m1", { "flexible", "armored" }));
+  auto flexible = store.create(makeCableType(2, "m1", { "flexible" }));
+  auto repeated =
+      store.create(makeCableType(3, "m2", { "armored", "armored" }));
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(
+              apiServer.url("/cable/type/property/name/armored"),
+              token,
+              QUrlQuery{ { "select", "documents" } }));
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(responseObject["matched"].toInt(), 2);
+
+  // Cable types come in order they were stored
+  auto cableTypes = responseObject["cableTypes"].toArray();
+  QCOMPARE(cableTypes.size(), 2);
+  QCOMPARE(cableTypes[0].toObject(), store.findById(both)->cableType());
+  QCOMPARE(cableTypes[1].toObject(), store.findById(repeated)->cableType());
+
+  QCOMPARE(idsOf(store.findByPropertyName("flexible", 10, false)),
+           (QSet<QString>{ both, flexible }));
+  // Default cable type has it
+  QCOMPARE(store.findByPropertyName("manufacturedBy", 10, false).matched,
+           std::size_t{ 1 });
+}
+
+void InvertedIndexes::indexesFollowWritesTest() {
+  test::api::CableTypeStore store;
+  std::vector<QString> ids;
+  for (int i = 0; i < 10; ++i) {
+    ids.push_back(store.create(makeCableType(i, "m1", { "flexible" })));
+  }
+
+  // Removed cable type moves last one into its row
+  QVERIFY(store.remove(ids[0]));
+  QVERIFY(store.replace(ids[1], makeCableType(1, "m2", { "armored" })));
+
+  auto m1 = idsOf(store.findByManufacturerId("m1", 100, false));
+  QCOMPARE(m1.size(), 8);
+  QVERIFY(not m1.contains(ids[0]));
+  QVERIFY(not m1.contains(ids[1]));
+  QVERIFY(m1.contains(ids[9]));
+  QCOMPARE(idsOf(store.findByManufacturerId("m2", 100, false)),
+           QSet<QString>{ ids[1] });
+  QCOMPARE(idsOf(store.findByPropertyName("armored", 100, false)),
+           QSet<QString>{ ids[1] });
+  QCOMPARE(store.findByPropertyName("flexible", 100, false).matched,
+           std::size_t{ 8 });
+
+  auto documents = store.findByManufacturerId("m1", 2, true);
+  QCOMPARE(documents.matched, std::size_t{ 8 });
+  QCOMPARE(documents.cableTypes.size(), std::size_t{ 2 });
+  QCOMPARE(documents.cableTypes[0], store.findById(documents.ids[0]));
+
+  for (const auto& id : ids) {
+    store.remove(id);
+  }
+  QCOMPARE(store.findByManufacturerId("m1", 100, false).matched,
+           std::size_t{ 0 });
+  QCOMPARE(store.postingBytes(), std::size_t{ 0 });
+}
+
+void InvertedIndexes::compactionTest() {
+  test::api::CableTypeStore store;
+  std::vector<QString> ids;
+  for (int i = 0; i < 100; ++i) {
+    ids.push_back(store.create(makeCableType(i, "m1", { "flexible" })));
+  }
+  const auto bytes = store.postingBytes();
+
+  // Replaced cable type counts as stored anew, so it moves to the end
+  std::mt19937_64 random{ 13 };
+  for (int i = 0; i < 5000; ++i) {
+    auto replaced = ids.begin() + random() % ids.size();
+    QVERIFY(store.replace(*replaced, makeCableType(i, "m1", { "flexible" })));
+    std::rotate(replaced, replaced + 1, ids.end());
+  }
+  QVERIFY(store.remove(ids.front()));
+  ids.erase(ids.begin());
+
+  auto matches = store.findByManufacturerId("m1", 1000, false);
+  QCOMPARE(matches.matched, std::size_t{ 99 });
+  QVERIFY(matches.ids == ids);
+  QVERIFY(store.findByPropertyName("flexible", 1000, false).ids == ids);
+
+  // Removed documents are dropped by compaction instead of piling up,
+  // each of them takes a byte in both posting lists until then
+  QVERIFY(store.postingBytes() < bytes + 2 * 2 * 1024);
+}
+
+QTEST_MAIN(InvertedIndexes)
+#include "InvertedIndexes.moc"
@@ -0,0 +1,147 @@
+#include <DefaultCableType.h>
+#include <MockApiServer.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+#include <QTest>
+#include <QUrlQuery>
+#include <utils.h>
+
+class ListCableTypes : public QObject {
+  Q_OBJECT
+
+private slots:
+  void listCableTypesTest_data();
+  void listCableTypesTest();
+
+  void walkPagesTest();
+};
+
+void ListCableTypes::listCableTypesTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<QString>("query");
+  QTest::addColumn<QJsonObject>("expectedResponseBody");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<QNetworkReply::NetworkError>("expectedNetworkError");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+
+  QJsonObject defaultCableTypeList{
+    { "cableTypes",
+     QJsonArray{
+          QJsonDocument::fromJson(test::api::defaultCableTypeData).object() } }
+  };
+
+  QTest::newRow("Superuser lists cable types of customer, cable types "
+                "returned in response and response code 200")
+      << "superuser" << "customer.code=bge" << defaultCableTypeList << 200
+      << QNetworkReply::NetworkError::NoError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Superuser lists cable types of all customers, cable types "
+                "returned in response and response code 200")
+      << "superuser" << "" << defaultCableTypeList << 200
+      << QNetworkReply::NetworkError::NoError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Superuser lists cable types of customer without them, empty "
+                "list returned in response and response code 200")
+      << "superuser" << "customer.code=abc"
+      << QJsonObject{ { "cableTypes", QJsonArray() } } << 200
+      << QNetworkReply::NetworkError::NoError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Admin lists cable types, error message with response code "
+                "401 returned (no permissions)")
+      << "admin" << "customer.code=bge"
+      << QJsonDocument::fromJson(R"({"cause": "Unauthorized"})").object() << 401
+      << QNetworkReply::NetworkError::AuthenticationRequiredError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("No token provided in request, error message with response "
+                "code 401 returned (no permissions)")
+      << "" << "customer.code=bge"
+      << QJsonDocument::fromJson(R"({"cause": "Unauthorized"})").object() << 401
+      << QNetworkReply::NetworkError::AuthenticationRequiredError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Request with invalid page size, error message with response "
+                "code 400 returned")
+      << "superuser" << "customer.code=bge&limit=0"
+      << QJsonDocument::fromJson(R"({"cause": "invalid page size"})").object()
+      << 400 << QNetworkReply::NetworkError::ProtocolInvalidOperationError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Request with invalid cursor, error message with response "
+                "code 400 returned")
+      << "superuser" << "customer.code=bge&cursor=not-a-cursor"
+      << QJsonDocument::fromJson(R"({"cause": "invalid cursor"})").object()
+      << 400 << QNetworkReply::NetworkError::ProtocolInvalidOperationError
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "superuser" << "customer.code=bge"
+      << QJsonDocument::fromJson(R"({"cause": "Database connection error"})")
+             .object()
+      << 500 << QNetworkReply::NetworkError::InternalServerError
+      << test::api::MockApiServer::State::DatabaseConnectionError;
+}
+
+void ListCableTypes::listCableTypesTest() {
+  QFETCH(QString, userRole);
+  QFETCH(QString, query);
+  QFETCH(QJsonObject, expectedResponseBody);
+  QFETCH(int, expectedResultCode);
+  QFETCH(QNetworkReply::NetworkError, expectedNetworkError);
+  QFETCH(test::api::MockApiServer::State, apiState);
+
+  test::api::MockApiServer apiServer{ apiState };
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(
+              apiServer.url("/cable/type"), token, QUrlQuery(query)));
+
+  QCOMPARE(responseObject, expectedResponseBody);
+  QCOMPARE(returnCode, expectedResultCode);
+  QCOMPARE(networkError, expectedNetworkError);
+}
+
+void ListCableTypes::walkPagesTest() {
+  test::api::MockApiServer apiServer;
+  for (int i = 0; i < 25; ++i) {
+    apiServer.store().create(test::utils::makeCableType(i, "bge"));
+    apiServer.store().create(test::utils::makeCableType(i, "abc"));
+  }
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  QSet<QString> listedIds;
+  QString cursor;
+  int pages = 0;
+  do {
+    QUrlQuery query{ { "customer.code", "bge" }, { "limit", "10" } };
+    if (not cursor.isEmpty()) {
+      query.addQueryItem("cursor", cursor);
+    }
+    auto [responseObject, returnCode, networkError] =
+        test::utils::makeGetRequest(test::utils::makeRequest(
+            apiServer.url("/cable/type"), token, query));
+    QCOMPARE(returnCode, 200);
+
+    for (const auto& cableType : responseObject["cableTypes"].toArray()) {
+      QCOMPARE(cableType["customer"]["code"].toString(), QString("bge"));
+      listedIds.insert(cableType["id"].toString());
+    }
+    cursor = responseObject["nextCursor"].toString();
+    ++pages;
+  } while (not cursor.isEmpty());
+
+  QCOMPARE(pages, 3);
+  QCOMPARE(listedIds.size(), 26);
+}
+
+QTEST_MAIN(ListCableTypes)
+#include "ListCableTypes.moc"
@@ -0,0 +1,86 @@
+#include <Metrics.h>
+#include <MockApiServer.h>
+#include <QEventLoop>
+#include <QNetworkReply>
+#include <QObject>
+#include <QTest>
+#include <utils.h>
+
+class Metrics : public QObject {
+  Q_OBJECT
+
+private slots:
+  void countRequestsTest();
+  void exposeMetricsTest();
+};
+
+namespace {
+  using State = test::api::MockApiServer::State;
+
+  static constexpr char getByIdRoute[] = "GET /cable/type/id/<arg>";
+
+  QNetworkRequest makeGetByIdRequest(const test::api::MockApiServer& apiServer,
+                                     const QString& token) {
+    return test::utils::makeRequest(
+        apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1"), token);
+  }
+
+  /*
+   * Metrics are plain text, so they are not read by JSON request helpers.
+   */
+  std::pair<QByteArray, QByteArray>
+  getMetrics(const test::api::MockApiServer& apiServer) {
+    QNetworkAccessManager manager;
+    std::unique_ptr<QNetworkReply> reply(
+        manager.get(QNetworkRequest(apiServer.url("/metrics"))));
+    QEventLoop loop;
+    QObject::connect(
+        reply.get(), &QNetworkReply::finished, &loop, &QEventLoop::quit);
+    loop.exec();
+    return { reply->header(QNetworkRequest::ContentTypeHeader)
+                 .toString()
+                 .toUtf8(),
+             reply->readAll() };
+  }
+} // namespace
+
+void Metrics::countRequestsTest() {
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  for (int i = 0; i < 3; ++i) {
+    test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+  }
+  test::utils::makeGetRequest(makeGetByIdRequest(apiServer, ""));
+
+  const auto* route = apiServer.metrics().find(getByIdRoute);
+  QVERIFY(nullptr != route);
+  QCOMPARE(route->requests(), 4u);
+  QCOMPARE(route->requests(State::Normal), 4u);
+  QCOMPARE(route->responses(200), 3u);
+  QCOMPARE(route->responses(401), 1u);
+  QCOMPARE(apiServer.metrics().find("GET /cable/type")->requests(), 0u);
+}
+
+void Metrics::exposeMetricsTest() {
+  test::api::MockApiServer apiServer{ State::DatabaseConnectionError };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+  test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+
+  auto [contentType, text] = getMetrics(apiServer);
+
+  QVERIFY(contentType.startsWith("text/plain; version=0.0.4"));
+  QVERIFY(text.contains("# TYPE api_mock_requests_total counter\n"));
+  QVERIFY(text.contains("api_mock_requests_total{route=\"GET "
+                        "/cable/type/id/<arg>\",state="
+                        "\"DatabaseConnectionError\"} 1\n"));
+  QVERIFY(text.contains("api_mock_responses_total{route=\"GET "
+                        "/cable/type/id/<arg>\",status=\"500\"} 1\n"));
+  QVERIFY(text.contains("api_mock_request_duration_seconds_bucket{route=\"GET "
+                        "/cable/type/id/<arg>\",le=\"+Inf\"} 1\n"));
+  QVERIFY(text.contains("api_mock_request_duration_seconds_count{route=\"GET "
+                        "/cable/type/id/<arg>\"} 1\n"));
+}
+
+QTEST_MAIN(Metrics)
+#include "Metrics.moc"
@@ -0,0 +1,267 @@
+#include <Metrics.h>
+#include <MockApiServer.h>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QSet>
+#include <QTest>
+#include <QUrlQuery>
+#include <RangeQuery.h>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <utils.h>
+
+class RangeQuery : public QObject {
+  Q_OBJECT
+
+private slots:
+  void invalidRangeQueryTest_data();
+  void invalidRangeQueryTest();
+
+  void rangeQueryTest_data();
+  void rangeQueryTest();
+
+  void documentsTest();
+  void kernelsAgreeTest();
+};
+
+namespace {
+  static constexpr int customerCableTypeCount = 20;
+
+  /*
+   * Voltage of cable type is its index, price is ten times index,
+   * every fifth cable type has no price.
+   */
+  QJsonObject makeCableType(int index, const QString& customerCode) {
+    auto cableType = test::utils::makeCableType(index, customerCode);
+    cableType["voltage"] = QJsonObject{ { "value", index }, { "unit", "V" } };
+    if (0 == index % 5) {
+      cableType.remove("currentPrice");
+    } else {
+      cableType["currentPrice"] =
+          QJsonObject{ { "value", 10.0 * index }, { "unit", "USD" } };
+    }
+    return cableType;
+  }
+
+  void fillStore(test::api::MockApiServer& apiServer) {
+    for (int i = 0; i < customerCableTypeCount; ++i) {
+      apiServer.store().create(makeCableType(i, "bge"));
+      apiServer.store().create(makeCableType(i, "abc"));
+    }
+  }
+} // namespace
+
+void RangeQuery::invalidRangeQueryTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<QString>("query");
+  QTest::addColumn<QJsonObject>("expectedResponseBody");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+
+  auto invalidQuery =
+      QJsonDocument::fromJson(R"({"cause": "invalid range query"})").object();
+
+  QTest::newRow("Admin queries ranges, error message with response code "
+                "401 returned (no permissions)")
+      << "admin" << "voltage.min=1"
+      << QJsonDocument::fromJson(R"({"cause": "Unauthorized"})").object() << 401
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Query without predicates, error message with response code "
+                "400 returned")
+      << "superuser" << "customer.code=bge" << invalidQuery << 400
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Query on field which is not numeric, error message with "
+                "response code 400 returned")
+      << "superuser" << "identifier.min=1" << invalidQuery << 400
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Query with bound which is not number, error message with "
+                "response code 400 returned")
+      << "superuser" << "voltage.max=high" << invalidQuery << 400
+      << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Query with unknown selection, error message with "
+                "response code 400 returned")
+      << "superuser" << "voltage.max=1&select=names"
+      << QJsonDocument::fromJson(R"({"cause": "invalid selection"})").object()
+      << 400 << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Query with invalid page size, error message with "
+                "response code 400 returned")
+      << "superuser" << "voltage.max=1&limit=0"
+      << QJsonDocument::fromJson(R"({"cause": "invalid page size"})").object()
+      << 400 << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "superuser" << "voltage.min=1"
+      << QJsonDocument::fromJson(R"({"cause": "Database connection error"})")
+             .object()
+      << 500 << test::api::MockApiServer::State::DatabaseConnectionError;
+}
+
+void RangeQuery::invalidRangeQueryTest() {
+  QFETCH(QString, userRole);
+  QFETCH(QString, query);
+  QFETCH(QJsonObject, expectedResponseBody);
+  QFETCH(int, expectedResultCode);
+  QFETCH(test::api::MockApiServer::State, apiState);
+
+  test::api::MockApiServer apiServer{ apiState };
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(test::utils::makeRequest(
+          apiServer.url("/cable/type/range"), token, QUrlQuery(query)));
+
+  QCOMPARE(responseObject, expectedResponseBody);
+  QCOMPARE(returnCode, expectedResultCode);
+}
+
+void RangeQuery::rangeQueryTest_data() {
+  QTest::addColumn<QString>("query");
+  QTest::addColumn<QSet<QString>>("expectedIdentifiers");
+  QTest::addColumn<int>("expectedMatched");
+
+  QTest::newRow("Voltage between bounds, both are inclusive")
+      << "voltage.min=3&voltage.max=5&customer.code=bge"
+      << QSet<QString>{ "3-al-1c-trxple", "4-al-1c-trxple", "5-al-1c-trxple" }
+      << 3;
+
+  QTest::newRow("Price under bound, cable types without price don't match")
+      << "currentPrice.max=60&customer.code=bge"
+      << QSet<QString>{ "1-al-1c-trxple", "2-al-1c-trxple",
+                        "3-al-1c-trxple", "4-al-1c-trxple",
+                        "6-al-1c-trxple" }
+      << 5;
+
+  QTest::newRow("Bounds of the same field are intersected")
+      << "voltage.min=1&voltage.min=18&customer.code=bge"
+      << QSet<QString>{ "18-al-1c-trxple", "19-al-1c-trxple" } << 2;
+
+  QTest::newRow("Predicates on many fields, all must match")
+      << "voltage.min=8&currentPrice.max=110&customer.code=bge"
+      << QSet<QString>{ "8-al-1c-trxple", "9-al-1c-trxple",
+                        "11-al-1c-trxple" }
+      << 3;
+
+  QTest::newRow("All customers, each identifier matches twice")
+      << "voltage.min=19" << QSet<QString>{ "19-al-1c-trxple" } << 2;
+
+  QTest::newRow("Customer without cable types, nothing matches")
+      << "voltage.min=0&customer.code=xyz" << QSet<QString>{} << 0;
+
+  QTest::newRow("Matched count is not limited by page size")
+      << "voltage.min=0&customer.code=bge&limit=1" << QSet<QString>{}
+      << customerCableTypeCount;
+}
+
+void RangeQuery::rangeQueryTest() {
+  QFETCH(QString, query);
+  QFETCH(QSet<QString>, expectedIdentifiers);
+  QFETCH(int, expectedMatched);
+
+  test::api::MockApiServer apiServer;
+  fillStore(apiServer);
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(test::utils::makeRequest(
+          apiServer.url("/cable/type/range"), token, QUrlQuery(query)));
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(responseObject["matched"].toInt(), expectedMatched);
+
+  auto ids = responseObject["ids"].toArray();
+  auto limit = QUrlQuery(query).queryItemValue("limit");
+  QCOMPARE(ids.size(),
+           limit.isEmpty() ? expectedMatched
+                           : std::min(expectedMatched, limit.toInt()));
+  QSet<QString> identifiers;
+  for (const auto& id : ids) {
+    auto stored = apiServer.store().findById(id.toString());
+    QVERIFY(stored);
+    identifiers.insert(stored->cableType()["identifier"].toString());
+  }
+  if (limit.isEmpty()) {
+    QCOMPARE(identifiers, expectedIdentifiers);
+  }
+
+  auto scan = responseObject["scan"].toObject();
+  // Default cable type was replaced by one with the same identifier
+  QCOMPARE(scan["rows"].toInt(), 2 * customerCableTypeCount);
+  QVERIFY(scan["rowsPerSecond"].toDouble() >= 0);
+  QCOMPARE(scan["kernel"].toString(),
+           test::api::nameOf(test::api::bestScanKernel()));
+  QCOMPARE(apiServer.metrics().scannedRows(),
+           quint64{ 2 * customerCableTypeCount });
+}
+
+void RangeQuery::documentsTest() {
+  test::api::MockApiServer apiServer;
+  fillStore(apiServer);
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  QUrlQuery query{ { "voltage.min", "2" },
+                   { "voltage.max", "2" },
+                   { "customer.code", "abc" },
+                   { "select", "documents" } };
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(test::utils::makeRequest(
+          apiServer.url("/cable/type/range"), token, query));
+  QCOMPARE(returnCode, 200);
+
+  auto cableTypes = responseObject["cableTypes"].toArray();
+  QCOMPARE(cableTypes.size(), 1);
+  auto cableType = cableTypes.first().toObject();
+  QCOMPARE(cableType, apiServer.store()
+                          .findById(cableType["id"].toString())
+                          ->cableType());
+  QCOMPARE(cableType["customer"]["code"].toString(), QString("abc"));
+  QVERIFY(not responseObject.contains("ids"));
+}
+
+void RangeQuery::kernelsAgreeTest() {
+  std::mt19937_64 random{ 42 };
+  std::uniform_real_distribution<double> distribution(0.0, 100.0);
+
+  // Sizes around word boundaries, so tails of vector kernels are covered
+  for (std::size_t size : { 0, 1, 63, 64, 65, 130, 1000 }) {
+    std::vector<double> values(size);
+    for (auto& value : values) {
+      value = 0 == random() % 7 ? std::nan("") : distribution(random);
+    }
+
+    std::vector<quint64> expected;
+    for (auto kernel : { test::api::ScanKernel::Scalar,
+                         test::api::ScanKernel::Sse2,
+                         test::api::ScanKernel::Avx2 }) {
+      if (not test::api::isSupported(kernel)) {
+        continue;
+      }
+      std::vector<quint64> matches((size + 63) / 64, ~quint64{ 0 });
+      test::api::scanRange(kernel, values, 20.0, 60.0, matches);
+      test::api::scanRange(kernel,
+                           values,
+                           30.0,
+                           std::numeric_limits<double>::infinity(),
+                           matches);
+      if (test::api::ScanKernel::Scalar == kernel) {
+        expected = matches;
+      }
+      QVERIFY(matches == expected);
+
+      for (std::size_t row = 0; row < size; ++row) {
+        bool matched = (matches[row / 64] >> (row % 64)) & 1;
+        QCOMPARE(matched, values[row] >= 30.0 and values[row] <= 60.0);
+      }
+    }
+  }
+}
+
+QTEST_MAIN(RangeQuery)
+#include "RangeQuery.moc"
@@ -0,0 +1,219 @@
+#include <DefaultCableType.h>
+#include <Latency.h>
+#include <MockApiServer.h>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTcpSocket>
+#include <QTest>
+#include <QTimer>
+#include <random>
+#include <utils.h>
+
+class RouteProfiles : public QObject {
+  Q_OBJECT
+
+private slots:
+  void faultTest_data();
+  void faultTest();
+
+  void burstTest();
+  void latencyTest();
+  void histogramLatencyTest();
+  void pipelinedLatencyTest();
+  void delayedResponseDoesNotStallOthersTest();
+};
+
+namespace {
+  using MockApiServer = test::api::MockApiServer;
+  using namespace std::chrono_literals;
+
+  static constexpr char getByIdRoute[] = "GET /cable/type/id/<arg>";
+
+  QNetworkRequest makeGetByIdRequest(const MockApiServer& apiServer,
+                                     const QString& token) {
+    return test::utils::makeRequest(
+        apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1"), token);
+  }
+
+  MockApiServer::Options
+  optionsOf(MockApiServer::RouteProfile profile,
+            const QString& route = getByIdRoute) {
+    MockApiServer::Options options;
+    options.routeProfiles.emplace(route, std::move(profile));
+    return options;
+  }
+} // namespace
+
+void RouteProfiles::faultTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<double>("probability");
+  QTest::addColumn<QJsonObject>("expectedResponseBody");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<QNetworkReply::NetworkError>("expectedNetworkError");
+
+  QTest::newRow("Fault certain to happen, error message of fault state with "
+                "response code 500 returned")
+      << "superuser" << 1.0
+      << QJsonDocument::fromJson(R"({"cause": "Database connection error"})")
+             .object()
+      << 500 << QNetworkReply::NetworkError::InternalServerError;
+
+  QTest::newRow("Fault never happening, cable type returned in response and "
+                "response code 200")
+      << "superuser" << 0.0
+      << QJsonDocument::fromJson(test::api::defaultCableTypeData).object()
+      << 200 << QNetworkReply::NetworkError::NoError;
+
+  QTest::newRow("Fault certain to happen but no token provided, error message "
+                "with response code 401 returned (no permissions)")
+      << "" << 1.0
+      << QJsonDocument::fromJson(R"({"cause": "Unauthorized"})").object() << 401
+      << QNetworkReply::NetworkError::AuthenticationRequiredError;
+}
+
+void RouteProfiles::faultTest() {
+  QFETCH(QString, userRole);
+  QFETCH(double, probability);
+  QFETCH(QJsonObject, expectedResponseBody);
+  QFETCH(int, expectedResultCode);
+  QFETCH(QNetworkReply::NetworkError, expectedNetworkError);
+
+  MockApiServer apiServer{
+    MockApiServer::State::Normal,
+    optionsOf({ .faults = { { MockApiServer::State::DatabaseConnectionError,
+                              probability } } })
+  };
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+
+  QCOMPARE(responseObject, expectedResponseBody);
+  QCOMPARE(returnCode, expectedResultCode);
+  QCOMPARE(networkError, expectedNetworkError);
+}
+
+void RouteProfiles::burstTest() {
+  // Burst lasting whole period is always active
+  MockApiServer apiServer{
+    MockApiServer::State::Normal,
+    optionsOf({ .burst = MockApiServer::Burst{
+                    .period = 1h,
+                    .length = 1h,
+                    .faults = { { MockApiServer::State::DatabaseConnectionError,
+                                  1.0 } } } })
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+
+  QCOMPARE(returnCode, 500);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::InternalServerError);
+}
+
+void RouteProfiles::latencyTest() {
+  MockApiServer apiServer{
+    MockApiServer::State::Normal,
+    optionsOf({ .latency = test::api::latency::Constant{ 200ms } })
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  QElapsedTimer elapsed;
+  elapsed.start();
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(makeGetByIdRequest(apiServer, token));
+
+  QVERIFY(elapsed.elapsed() >= 200);
+  QCOMPARE(responseObject,
+           QJsonDocument::fromJson(test::api::defaultCableTypeData).object());
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::NoError);
+}
+
+void RouteProfiles::histogramLatencyTest() {
+  // Bucket without weight is never picked, latency is within picked one
+  const test::api::latency::Distribution histogram =
+      test::api::latency::Histogram{ {
+          { .upperBound = 1ms, .weight = 0.0 },
+          { .upperBound = 2ms, .weight = 3.0 },
+          { .upperBound = 4ms, .weight = 1.0 },
+      } };
+  std::mt19937_64 random{ 17 };
+  auto slow = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto delay = test::api::latency::sample(histogram, random);
+    QVERIFY(delay >= 1ms and delay <= 4ms);
+    slow += delay > 2ms ? 1 : 0;
+  }
+  QVERIFY(slow > 150 and slow < 350);
+}
+
+void RouteProfiles::pipelinedLatencyTest() {
+  MockApiServer apiServer{
+    MockApiServer::State::Normal,
+    optionsOf({ .latency = test::api::latency::Constant{ 200ms } })
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  // Request routed after one pipelined before it is delayed as well
+  auto url = apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1");
+  auto request = "GET " + url.path().toUtf8() +
+                 " HTTP/1.1\r\n"
+                 "Host: " +
+                 url.authority().toUtf8() +
+                 "\r\n"
+                 "Authorization: " +
+                 token.toUtf8() + "\r\n\r\n";
+
+  QTcpSocket socket;
+  QByteArray responses;
+  QEventLoop loop;
+  QObject::connect(&socket, &QTcpSocket::readyRead, &loop, [&] {
+    responses += socket.readAll();
+    if (2 == responses.count("HTTP/1.1 200")) {
+      loop.quit();
+    }
+  });
+  QTimer::singleShot(5s, &loop, &QEventLoop::quit);
+
+  QElapsedTimer elapsed;
+  elapsed.start();
+  socket.connectToHost(url.host(), static_cast<quint16>(url.port()));
+  socket.write(request + request);
+  loop.exec();
+
+  QCOMPARE(responses.count("HTTP/1.1 200"), qsizetype{ 2 });
+  QVERIFY(elapsed.elapsed() >= 200);
+  QCOMPARE(apiServer.metrics().find(getByIdRoute)->skippedDelays(),
+           quint64{ 0 });
+}
+
+void RouteProfiles::delayedResponseDoesNotStallOthersTest() {
+  MockApiServer apiServer{
+    MockApiServer::State::Normal,
+    optionsOf({ .latency = test::api::latency::Constant{ 1s } })
+  };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  test::utils::Client delayedClient;
+  auto delayed = test::utils::sendRequest(
+      delayedClient, { "GET", makeGetByIdRequest(apiServer, token) });
+
+  QNetworkRequest request(apiServer.url("/cable/type/catid/1622475"));
+  request.setRawHeader("Authorization", token.toLocal8Bit());
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(request);
+
+  QCOMPARE(returnCode, 200);
+  QVERIFY(not delayed.isFinished());
+  auto [delayedObject, delayedCode, delayedError] =
+      test::utils::waitForResults(delayed).front();
+  QCOMPARE(delayedCode, 200);
+}
+
+QTEST_MAIN(RouteProfiles)
+#include "RouteProfiles.moc"
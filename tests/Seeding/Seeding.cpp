@@ -0,0 +1,125 @@
+#include <MockApiServer.h>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <Seeding.h>
+#include <utils.h>
+
+class Seeding : public QObject {
+  Q_OBJECT
+
+private slots:
+  void seedStoreTest_data();
+  void seedStoreTest();
+
+  void seedApiServerTest();
+  void missingSeedFileTest();
+};
+
+namespace {
+  static constexpr int seededCount = 100;
+
+  QJsonObject makeCableType(int index) {
+    auto cableType = test::utils::makeCableType(index);
+    cableType["id"] = QString("%1").arg(index, 24, 10, QChar('0'));
+    return cableType;
+  }
+
+  /*
+   * Seed file with seeded cable types, blank lines, invalid line,
+   * cable type without id and duplicate of the first one.
+   */
+  QString writeSeedFile(const QTemporaryDir& directory) {
+    auto path = directory.filePath("seed.ndjson");
+    QFile file(path);
+    if (not file.open(QIODevice::WriteOnly)) {
+      return {};
+    }
+    for (int i = 0; i < seededCount; ++i) {
+      file.write(
+          QJsonDocument(makeCableType(i)).toJson(QJsonDocument::Compact));
+      file.write(0 == i % 10 ? "\r\n\n" : "\n");
+    }
+    file.write("{not json\n");
+    auto withoutId = makeCableType(seededCount);
+    withoutId.remove("id");
+    file.write(QJsonDocument(withoutId).toJson(QJsonDocument::Compact) + '\n');
+    // Last line has no newline
+    file.write(QJsonDocument(makeCableType(0)).toJson(QJsonDocument::Compact));
+    return path;
+  }
+} // namespace
+
+void Seeding::seedStoreTest_data() {
+  QTest::addColumn<int>("threadCount");
+
+  QTest::newRow("Seed file parsed on single thread, all valid cable types "
+                "stored")
+      << 1;
+  QTest::newRow("Seed file parsed on 7 threads, all valid cable types stored")
+      << 7;
+  QTest::newRow("Seed file split into more chunks than it has lines, all "
+                "valid cable types stored")
+      << 500;
+}
+
+void Seeding::seedStoreTest() {
+  QFETCH(int, threadCount);
+
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = writeSeedFile(directory);
+
+  test::api::CableTypeStore store;
+  auto result = test::api::seedFromNdjson(store, path, threadCount);
+
+  QCOMPARE(result.stored, std::size_t{ seededCount });
+  QCOMPARE(result.rejected, std::size_t{ 3 });
+  QCOMPARE(store.size(), std::size_t{ seededCount });
+  for (int i = 0; i < seededCount; ++i) {
+    auto cableType = makeCableType(i);
+    auto stored = store.findByCatIdAndCustomerCode(3000000 + i, "bge");
+    QVERIFY(nullptr != stored);
+    QCOMPARE(stored->cableType(), cableType);
+    QCOMPARE(store.findByIdentifier(cableType["identifier"].toString()),
+             stored);
+  }
+  QCOMPARE(store.list("bge", {}, 1000).cableTypes.size(),
+           std::size_t{ seededCount });
+}
+
+void Seeding::seedApiServerTest() {
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .seedPath =
+                                           writeSeedFile(directory) }
+  };
+  QCOMPARE(apiServer.store().size(), std::size_t{ seededCount + 1 });
+
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+  QNetworkRequest request(
+      apiServer.url("/cable/type/identifier/42-al-1c-trxple"));
+  request.setRawHeader("Authorization", token.toLocal8Bit());
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(request);
+
+  QCOMPARE(responseObject, makeCableType(42));
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::NoError);
+}
+
+void Seeding::missingSeedFileTest() {
+  test::api::CableTypeStore store;
+  QVERIFY_THROWS_EXCEPTION(
+      std::runtime_error,
+      test::api::seedFromNdjson(store, "/nonexistent/seed.ndjson"));
+}
+
+QTEST_MAIN(Seeding)
+#include "Seeding.moc"
@@ -0,0 +1,200 @@
+#include <DefaultCableType.h>
+#include <Latency.h>
+#include <MockApiServer.h>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTemporaryDir>
+#include <QTest>
+#include <Snapshot.h>
+#include <utils.h>
+
+class Snapshot : public QObject {
+  Q_OBJECT
+
+private slots:
+  void roundTripTest();
+  void loadIntoApiServerTest();
+  void delayedResponseOfRemovedCableTypeTest();
+
+  void invalidSnapshotTest_data();
+  void invalidSnapshotTest();
+};
+
+namespace {
+  static constexpr int storedCount = 50;
+
+  void fillStore(test::api::CableTypeStore& store) {
+    store.insert(QJsonDocument::fromJson(test::api::defaultCableTypeData)
+                     .object());
+    for (int i = 0; i < storedCount; ++i) {
+      store.create(
+          test::utils::makeCableType(i, QString("customer-%1").arg(i % 3)));
+    }
+  }
+
+  QByteArray readFile(const QString& path) {
+    QFile file(path);
+    return file.open(QIODevice::ReadOnly) ? file.readAll() : QByteArray();
+  }
+
+  void writeFile(const QString& path, const QByteArray& data) {
+    QFile file(path);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+      file.write(data);
+    }
+  }
+} // namespace
+
+void Snapshot::roundTripTest() {
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = directory.filePath("store.snapshot");
+
+  test::api::CableTypeStore saved;
+  fillStore(saved);
+  test::api::saveSnapshot(saved, path);
+
+  test::api::CableTypeStore loaded;
+  QCOMPARE(test::api::loadSnapshot(loaded, path),
+           std::size_t{ storedCount + 1 });
+  QCOMPARE(loaded.size(), saved.size());
+
+  for (const auto& original : saved.entries()) {
+    auto id = original->cableType()["id"].toString();
+    auto restored = loaded.findById(id);
+    QVERIFY(nullptr != restored);
+    QCOMPARE(restored->json(), original->json());
+    QCOMPARE(restored->etag(test::api::ContentEncoding::Gzip),
+             original->etag(test::api::ContentEncoding::Gzip));
+    QCOMPARE(restored->cableType(), original->cableType());
+    QCOMPARE(loaded.findByIdentifierAndCustomerCode(
+                 original->cableType()["identifier"].toString(),
+                 original->cableType()["customer"]
+                     .toObject()["code"]
+                     .toString()),
+             restored);
+  }
+  QCOMPARE(loaded.list("customer-1", {}, 1000).cableTypes.size(),
+           saved.list("customer-1", {}, 1000).cableTypes.size());
+
+  // Columns and inverted indexes are filled from typed fields of records
+  QCOMPARE(loaded.statistics().customers.size(),
+           saved.statistics().customers.size());
+  QCOMPARE(loaded.findByPropertyName("manufacturedBy", 0, false).matched,
+           saved.findByPropertyName("manufacturedBy", 0, false).matched);
+  QCOMPARE(loaded.postingBytes(), saved.postingBytes());
+
+  // Restored cable types are indexed like any other, so they can be removed
+  auto removed = loaded.findByCatId(4000000)->cableType()["id"].toString();
+  QVERIFY(loaded.remove(removed));
+  QVERIFY(nullptr == loaded.findByCatId(4000000));
+}
+
+void Snapshot::loadIntoApiServerTest() {
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = directory.filePath("store.snapshot");
+  test::api::CableTypeStore saved;
+  fillStore(saved);
+  test::api::saveSnapshot(saved, path);
+
+  test::api::MockApiServer apiServer{
+    test::api::MockApiServer::State::Normal,
+    test::api::MockApiServer::Options{ .snapshotPath = path }
+  };
+  QCOMPARE(apiServer.store().size(), std::size_t{ storedCount + 1 });
+
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(test::utils::makeRequest(
+          apiServer.url("/cable/type/catid/1000007"), token));
+
+  QCOMPARE(responseObject, saved.findByCatId(1000007)->cableType());
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::NoError);
+}
+
+void Snapshot::delayedResponseOfRemovedCableTypeTest() {
+  using namespace std::chrono_literals;
+
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = directory.filePath("store.snapshot");
+  test::api::CableTypeStore saved;
+  saved.insert(
+      QJsonDocument::fromJson(test::api::defaultCableTypeData).object());
+  test::api::saveSnapshot(saved, path);
+
+  test::api::MockApiServer::Options options{ .snapshotPath = path };
+  options.routeProfiles.emplace(
+      "GET /cable/type/catid/<arg>",
+      test::api::MockApiServer::RouteProfile{
+          .latency = test::api::latency::Constant{ 200ms } });
+  test::api::MockApiServer apiServer{ test::api::MockApiServer::State::Normal,
+                                      options };
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+
+  // Only cable type of snapshot is removed while its response is delayed,
+  // which unmaps snapshot before response is sent
+  auto response = test::utils::sendRequest(
+      test::utils::threadClient(),
+      { "GET",
+        test::utils::makeRequest(apiServer.url("/cable/type/catid/4000000"),
+                                 token) });
+  QTest::qWait(50);
+  QVERIFY(apiServer.store().remove(
+      saved.findByCatId(4000000)->cableType()["id"].toString()));
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::waitForResults(response).front();
+  QCOMPARE(responseObject, saved.findByCatId(4000000)->cableType());
+  QCOMPARE(returnCode, 200);
+  QCOMPARE(networkError, QNetworkReply::NetworkError::NoError);
+}
+
+void Snapshot::invalidSnapshotTest_data() {
+  QTest::addColumn<QString>("damage");
+
+  QTest::newRow("Snapshot file missing, loading fails") << "missing";
+  QTest::newRow("Snapshot file truncated, loading fails") << "truncated";
+  QTest::newRow("Snapshot of other version, loading fails") << "version";
+  QTest::newRow("Snapshot record out of file bounds, loading fails")
+      << "record";
+}
+
+void Snapshot::invalidSnapshotTest() {
+  QFETCH(QString, damage);
+
+  QTemporaryDir directory;
+  QVERIFY(directory.isValid());
+  auto path = directory.filePath("store.snapshot");
+  test::api::CableTypeStore saved;
+  fillStore(saved);
+  test::api::saveSnapshot(saved, path);
+
+  auto snapshot = readFile(path);
+  if ("missing" == damage) {
+    QFile::remove(path);
+  } else if ("truncated" == damage) {
+    writeFile(path, snapshot.left(snapshot.size() / 2));
+  } else if ("version" == damage) {
+    // Version follows 8 byte magic
+    snapshot[8] = static_cast<char>(snapshot[8] + 1);
+    writeFile(path, snapshot);
+  } else if ("record" == damage) {
+    // Size of JSON of first record, which follows 64 byte header
+    // and its two 8 byte offsets
+    snapshot[64 + 16 + 3] = static_cast<char>(0x7f);
+    writeFile(path, snapshot);
+  }
+
+  test::api::CableTypeStore loaded;
+  QVERIFY_THROWS_EXCEPTION(std::runtime_error,
+                           test::api::loadSnapshot(loaded, path));
+  QCOMPARE(loaded.size(), std::size_t{ 0 });
+}
+
+QTEST_MAIN(Snapshot)
+#include "Snapshot.moc"
@@ -0,0 +1,201 @@
+#include <CableTypeStore.h>
+#include <MockApiServer.h>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <random>
+#include <utils.h>
+
+class Statistics : public QObject {
+  Q_OBJECT
+
+private slots:
+  void statisticsRouteTest_data();
+  void statisticsRouteTest();
+
+  void updatedOnWritesTest();
+  void matchesRecomputedTest();
+};
+
+namespace {
+  QJsonObject makeCableType(int index,
+                            const QString& customerCode,
+                            const QString& manufacturerId,
+                            double price) {
+    auto cableType = test::utils::makeCableType(index, customerCode);
+    cableType["currentPrice"] =
+        QJsonObject{ { "value", price }, { "unit", "USD" } };
+    cableType["manufacturer"] =
+        QJsonObject{ { "id", manufacturerId }, { "name", "Kerite" } };
+    return cableType;
+  }
+
+  const test::api::GroupSummary*
+  findGroup(const std::vector<test::api::GroupSummary>& groups,
+            const QString& key) {
+    auto group = std::find_if(
+        groups.begin(), groups.end(), [&key](const auto& candidate) {
+          return candidate.key == key;
+        });
+    return group == groups.end() ? nullptr : &*group;
+  }
+
+  QJsonObject findGroup(const QJsonArray& groups,
+                        const QString& keyName,
+                        const QString& key) {
+    for (const auto& group : groups) {
+      if (group[keyName].toString() == key) {
+        return group.toObject();
+      }
+    }
+    return {};
+  }
+} // namespace
+
+void Statistics::statisticsRouteTest_data() {
+  QTest::addColumn<QString>("userRole");
+  QTest::addColumn<int>("expectedResultCode");
+  QTest::addColumn<test::api::MockApiServer::State>("apiState");
+
+  QTest::newRow("Superuser gets statistics, aggregates of default cable type "
+                "returned in response and response code 200")
+      << "superuser" << 200 << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Admin gets statistics, error message with response code "
+                "401 returned (no permissions)")
+      << "admin" << 401 << test::api::MockApiServer::State::Normal;
+
+  QTest::newRow("Database connection error, error message with response code "
+                "500 returned")
+      << "superuser" << 500
+      << test::api::MockApiServer::State::DatabaseConnectionError;
+}
+
+void Statistics::statisticsRouteTest() {
+  QFETCH(QString, userRole);
+  QFETCH(int, expectedResultCode);
+  QFETCH(test::api::MockApiServer::State, apiState);
+
+  test::api::MockApiServer apiServer{ apiState };
+  auto token = test::utils::loginUser(apiServer.url(), userRole);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(apiServer.url("/cable/type/stats"), token));
+  QCOMPARE(returnCode, expectedResultCode);
+  if (200 != expectedResultCode) {
+    return;
+  }
+
+  auto customer =
+      findGroup(responseObject["customers"].toArray(), "code", "bge");
+  QCOMPARE(customer["count"].toInt(), 1);
+  auto price = customer["currentPrice"].toObject();
+  QCOMPARE(price["count"].toInt(), 1);
+  QCOMPARE(price["sum"].toDouble(), 22.43);
+  QCOMPARE(price["min"].toDouble(), 22.43);
+  QCOMPARE(price["max"].toDouble(), 22.43);
+  QCOMPARE(price["mean"].toDouble(), 22.43);
+  QVERIFY(customer.contains("voltage"));
+  QVERIFY(customer.contains("material.weight.net"));
+
+  auto manufacturer = findGroup(responseObject["manufacturers"].toArray(),
+                                "id",
+                                "5f3bc9e2502422053e08f9f1");
+  QCOMPARE(manufacturer["count"].toInt(), 1);
+}
+
+void Statistics::updatedOnWritesTest() {
+  test::api::MockApiServer apiServer;
+  auto& store = apiServer.store();
+  auto cheap = store.create(makeCableType(1, "abc", "m1", 5.0));
+  auto middle = store.create(makeCableType(2, "abc", "m1", 10.0));
+  auto expensive = store.create(makeCableType(3, "abc", "m2", 30.0));
+
+  auto statistics = store.statistics();
+  const auto* customer = findGroup(statistics.customers, "abc");
+  QVERIFY(customer);
+  QCOMPARE(customer->cableTypes, quint64{ 3 });
+  QCOMPARE(customer->fields[0].sum, 45.0);
+  QCOMPARE(customer->fields[0].min, 5.0);
+  QCOMPARE(customer->fields[0].max, 30.0);
+  QCOMPARE(customer->fields[0].mean, 15.0);
+
+  // Removing current min and max, next ones take their place
+  QVERIFY(store.remove(cheap));
+  QVERIFY(store.replace(expensive, makeCableType(3, "abc", "m1", 20.0)));
+  statistics = store.statistics();
+  customer = findGroup(statistics.customers, "abc");
+  QCOMPARE(customer->cableTypes, quint64{ 2 });
+  QCOMPARE(customer->fields[0].min, 10.0);
+  QCOMPARE(customer->fields[0].max, 20.0);
+  QVERIFY(not findGroup(statistics.manufacturers, "m2"));
+  QCOMPARE(findGroup(statistics.manufacturers, "m1")->cableTypes,
+           quint64{ 2 });
+
+  // Removing through API route updates statistics as well
+  auto token = test::utils::loginUser(apiServer.url(), "superuser");
+  auto [deletedObject, deleteCode, deleteError] =
+      test::utils::makeDeleteRequest(test::utils::makeRequest(
+          apiServer.url("/cable/type/id/" + middle), token));
+  QCOMPARE(deleteCode, 200);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(
+          test::utils::makeRequest(apiServer.url("/cable/type/stats"), token));
+  QCOMPARE(returnCode, 200);
+  auto group = findGroup(responseObject["customers"].toArray(), "code", "abc");
+  QCOMPARE(group["count"].toInt(), 1);
+  QCOMPARE(group["currentPrice"]["mean"].toDouble(), 20.0);
+}
+
+void Statistics::matchesRecomputedTest() {
+  test::api::CableTypeStore store;
+  std::mt19937_64 random{ 7 };
+  std::vector<QString> ids;
+  for (int i = 0; i < 500; ++i) {
+    auto customerCode = QString("c%1").arg(random() % 5);
+    auto manufacturerId = QString("m%1").arg(random() % 3);
+    auto price = static_cast<double>(random() % 1000);
+    auto operation = random() % 4;
+    if (0 == operation and not ids.empty()) {
+      auto id = ids[random() % ids.size()];
+      store.remove(id);
+      std::erase(ids, id);
+    } else if (1 == operation and not ids.empty()) {
+      store.replace(ids[random() % ids.size()],
+                    makeCableType(i, customerCode, manufacturerId, price));
+    } else {
+      ids.push_back(store.create(
+          makeCableType(i, customerCode, manufacturerId, price)));
+    }
+  }
+
+  // Full recomputation from stored documents
+  std::map<QString, std::vector<double>> pricesByCustomer;
+  for (const auto& entry : store.entries()) {
+    auto cableType = entry->cableType();
+    pricesByCustomer[cableType["customer"]["code"].toString()].push_back(
+        cableType["currentPrice"]["value"].toDouble());
+  }
+
+  auto statistics = store.statistics();
+  QCOMPARE(statistics.customers.size(), pricesByCustomer.size());
+  for (const auto& [customerCode, prices] : pricesByCustomer) {
+    const auto* group = findGroup(statistics.customers, customerCode);
+    QVERIFY(group);
+    const auto& price = group->fields[0];
+    QCOMPARE(price.count, quint64{ prices.size() });
+    QCOMPARE(price.min, *std::min_element(prices.begin(), prices.end()));
+    QCOMPARE(price.max, *std::max_element(prices.begin(), prices.end()));
+    QCOMPARE(price.sum, std::accumulate(prices.begin(), prices.end(), 0.0));
+  }
+}
+
+QTEST_MAIN(Statistics)
+#include "Statistics.moc"
@@ -0,0 +1,237 @@
+#include <MockApiServer.h>
+#include <QEventLoop>
+#include <QObject>
+#include <QTest>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <utils.h>
+
+class TestUtils : public QObject {
+  Q_OBJECT
+
+private slots:
+  void tokenCacheTest();
+  void tokenCacheExpiryTest();
+  void loginUserReusesTokenTest();
+
+  void keepAliveTest();
+  void pipeliningTest();
+
+  void batchTest();
+  void emptyBatchTest();
+};
+
+namespace {
+  static constexpr char defaultCableTypePath[] =
+      "/cable/type/id/5f3bc9e2502422053e08f9f1";
+
+  /*
+   * Runs event loop until reply is finished, gives its status code.
+   */
+  int waitForReply(QNetworkReply* reply) {
+    if (not reply->isFinished()) {
+      QEventLoop loop;
+      QObject::connect(
+          reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+      loop.exec();
+    }
+    reply->deleteLater();
+    return reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+  }
+} // namespace
+
+void TestUtils::tokenCacheTest() {
+  test::utils::TokenCache cache;
+  QVERIFY(not cache.find("admin"));
+  QCOMPARE(cache.misses(), quint64{ 1 });
+
+  cache.store("admin", "admin-token");
+  cache.store("user", "user-token");
+  QCOMPARE(cache.find("admin").value_or(""), QString("admin-token"));
+  QCOMPARE(cache.find("user").value_or(""), QString("user-token"));
+  QCOMPARE(cache.hits(), quint64{ 2 });
+
+  cache.invalidate("admin");
+  QVERIFY(not cache.find("admin"));
+  QCOMPARE(cache.find("user").value_or(""), QString("user-token"));
+
+  cache.invalidateAll();
+  QVERIFY(not cache.find("user"));
+  QCOMPARE(cache.hits(), quint64{ 3 });
+  QCOMPARE(cache.misses(), quint64{ 3 });
+}
+
+void TestUtils::tokenCacheExpiryTest() {
+  test::utils::TokenCache cache;
+  cache.setTimeToLive(std::chrono::milliseconds{ 20 });
+  cache.store("admin", "admin-token");
+  QVERIFY(cache.find("admin"));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds{ 40 });
+  QVERIFY(not cache.find("admin"));
+  QCOMPARE(cache.hits(), quint64{ 1 });
+  QCOMPARE(cache.misses(), quint64{ 1 });
+}
+
+void TestUtils::loginUserReusesTokenTest() {
+  auto& cache = test::utils::tokenCache();
+  cache.invalidate("admin");
+
+  // Each API Mock listens on its own port, token is shared anyway
+  test::api::MockApiServer first;
+  auto misses = cache.misses();
+  auto token = test::utils::loginUser(first.url(), "admin");
+  QCOMPARE(token.size(), qsizetype{ 155 });
+  QCOMPARE(cache.misses(), misses + 1);
+
+  test::api::MockApiServer second;
+  auto hits = cache.hits();
+  QCOMPARE(test::utils::loginUser(second.url(), "admin"), token);
+  QCOMPARE(cache.hits(), hits + 1);
+
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makeGetRequest(test::utils::makeRequest(
+          second.url("/cable/type/id/5f3bc9e2502422053e08f9f1"), token));
+  QCOMPARE(returnCode, 200);
+}
+
+void TestUtils::keepAliveTest() {
+  static constexpr int requestCount = 10;
+
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "user");
+  test::utils::Client client;
+  auto request = client.prepare(
+      test::utils::makeRequest(apiServer.url(defaultCableTypePath), token));
+
+  // Reply reports connecting only if it opens new connection
+  int connections = 0;
+  for (int i = 0; i < requestCount; ++i) {
+    auto* reply = client.manager().get(request);
+    QObject::connect(reply,
+                     &QNetworkReply::socketStartedConnecting,
+                     reply,
+                     [&connections] { ++connections; });
+    QCOMPARE(waitForReply(reply), 200);
+  }
+  QCOMPARE(connections, 1);
+
+  // Connection is opened again once dropped
+  client.clearConnections();
+  auto* reply = client.manager().get(request);
+  QObject::connect(reply,
+                   &QNetworkReply::socketStartedConnecting,
+                   reply,
+                   [&connections] { ++connections; });
+  QCOMPARE(waitForReply(reply), 200);
+  QCOMPARE(connections, 2);
+}
+
+void TestUtils::pipeliningTest() {
+  static constexpr int requestCount = 30;
+
+  test::api::MockApiServer apiServer;
+  auto token = test::utils::loginUser(apiServer.url(), "user");
+  test::utils::Client client{
+    test::utils::Client::Options{ .pipelining = true }
+  };
+  auto request = client.prepare(
+      test::utils::makeRequest(apiServer.url(defaultCableTypePath), token));
+  QVERIFY(request.attribute(QNetworkRequest::HttpPipeliningAllowedAttribute)
+              .toBool());
+
+  // Connection is known to keep alive after its first response,
+  // only then requests queued for it are pipelined
+  QCOMPARE(waitForReply(client.manager().get(request)), 200);
+
+  QList<QNetworkReply*> replies;
+  for (int i = 0; i < requestCount; ++i) {
+    replies.append(client.manager().get(request));
+  }
+  int pipelined = 0;
+  for (auto* reply : replies) {
+    QCOMPARE(waitForReply(reply), 200);
+    if (reply->attribute(QNetworkRequest::HttpPipeliningWasUsedAttribute)
+            .toBool()) {
+      ++pipelined;
+    }
+  }
+  QVERIFY(pipelined > 0);
+
+  // Without pipelining no request waits behind another one on connection
+  test::utils::Client sequential;
+  auto* reply = sequential.manager().get(sequential.prepare(request));
+  QCOMPARE(waitForReply(reply), 200);
+  QVERIFY(not reply->attribute(QNetworkRequest::HttpPipeliningWasUsedAttribute)
+                  .toBool());
+}
+
+void TestUtils::batchTest() {
+  static constexpr int requestCount = 12;
+  static constexpr int missingIndex = 5;
+
+  // Responses are delayed at random, so they arrive out of order
+  using namespace std::chrono_literals;
+  test::api::MockApiServer::Options options;
+  options.routeProfiles.emplace(
+      "GET /cable/type/identifier/<arg>",
+      test::api::MockApiServer::RouteProfile{
+          .latency = test::api::latency::Uniform{ 0ms, 50ms } });
+  test::api::MockApiServer apiServer{ test::api::MockApiServer::State::Normal,
+                                      options };
+  auto token = test::utils::loginUser(apiServer.url(), "user");
+
+  QList<test::utils::Request> requests;
+  for (int i = 0; i < requestCount; ++i) {
+    auto cableType = test::utils::makeCableType(100 + i, "abc");
+    auto identifier = cableType["identifier"].toString();
+    if (missingIndex != i) {
+      apiServer.store().create(cableType);
+    }
+    requests.append({ "GET",
+                      test::utils::makeRequest(
+                          apiServer.url("/cable/type/identifier/" + identifier),
+                          token) });
+  }
+
+  test::utils::Client client;
+  auto future = test::utils::sendBatch(client, requests);
+  QList<int> progress;
+  QFutureWatcher<test::utils::Response> watcher;
+  QObject::connect(&watcher,
+                   &QFutureWatcherBase::progressValueChanged,
+                   &watcher,
+                   [&progress](int value) { progress.append(value); });
+  watcher.setFuture(future);
+
+  auto responses = test::utils::waitForResults(future);
+  QCOMPARE(responses.size(), qsizetype{ requestCount });
+  for (int i = 0; i < requestCount; ++i) {
+    const auto& [responseObject, returnCode, networkError] = responses[i];
+    if (missingIndex == i) {
+      QCOMPARE(returnCode, 404);
+      continue;
+    }
+    QCOMPARE(returnCode, 200);
+    QCOMPARE(responseObject["identifier"].toString(),
+             QString("%1-al-1c-trxple").arg(100 + i));
+  }
+
+  QCOMPARE(future.progressMinimum(), 0);
+  QCOMPARE(future.progressMaximum(), requestCount);
+  QCOMPARE(future.progressValue(), requestCount);
+  QVERIFY(std::is_sorted(progress.begin(), progress.end()));
+}
+
+void TestUtils::emptyBatchTest() {
+  test::utils::Client client;
+  auto future = test::utils::sendBatch(client, {});
+  QVERIFY(future.isFinished());
+  QVERIFY(test::utils::waitForResults(future).isEmpty());
+  QCOMPARE(future.progressMaximum(), 0);
+  QCOMPARE(future.progressValue(), 0);
+}
+
+QTEST_MAIN(TestUtils)
+#include "TestUtils.moc"
@@ -0,0 +1,96 @@
+#include <MockApiServer.h>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QObject>
+#include <QTest>
+#include <utils.h>
+
+class WorkerThreads : public QObject {
+  Q_OBJECT
+
+private slots:
+  void roundTripTest();
+  void connectionsOfEveryWorkerServedTest();
+  void payloadExceedingLimitTest();
+};
+
+namespace {
+  static constexpr std::size_t workerCount = 2;
+
+  test::api::MockApiServer::Options workerOptions() {
+    return test::api::MockApiServer::Options{ .workerThreads = workerCount };
+  }
+} // namespace
+
+void WorkerThreads::roundTripTest() {
+  test::api::MockApiServer apiServer{ test::api::MockApiServer::State::Normal,
+                                      workerOptions() };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+  QCOMPARE(155ul, token.size());
+
+  auto [created, createCode, createError] = test::utils::makePostRequest(
+      test::utils::makeRequest(apiServer.url("/cable/type"), token),
+      QJsonDocument(test::utils::makeCableType(1, "abc")).toJson());
+  QCOMPARE(createCode, 200);
+  auto id = created["id"].toString();
+  QCOMPARE(id.size(), test::api::CableTypeStore::idLength);
+
+  auto [stored, getCode, getError] = test::utils::makeGetRequest(
+      test::utils::makeRequest(apiServer.url("/cable/type/id/" + id), token));
+  QCOMPARE(getCode, 200);
+  QCOMPARE(stored, created);
+
+  auto replaced = created;
+  replaced["comment"] = "served by worker thread";
+  auto [updated, putCode, putError] = test::utils::makePutRequest(
+      test::utils::makeRequest(apiServer.url("/cable/type/id/" + id), token),
+      QJsonDocument(replaced).toJson());
+  QCOMPARE(putCode, 200);
+  QCOMPARE(apiServer.store().findById(id)->cableType(), replaced);
+
+  auto [deleted, deleteCode, deleteError] = test::utils::makeDeleteRequest(
+      test::utils::makeRequest(apiServer.url("/cable/type/id/" + id), token));
+  QCOMPARE(deleteCode, 200);
+  QVERIFY(not apiServer.store().findById(id));
+}
+
+void WorkerThreads::connectionsOfEveryWorkerServedTest() {
+  test::api::MockApiServer apiServer{ test::api::MockApiServer::State::Normal,
+                                      workerOptions() };
+  auto token = test::utils::loginUser(apiServer.url(), "user");
+
+  // Connections are handed to workers round robin,
+  // so clients with own connections reach every worker
+  for (std::size_t i = 0; i < 2 * workerCount; ++i) {
+    test::utils::Client client;
+    auto [responseObject, returnCode, networkError] =
+        test::utils::makeGetRequest(
+            client,
+            test::utils::makeRequest(
+                apiServer.url("/cable/type/id/5f3bc9e2502422053e08f9f1"),
+                token));
+    QCOMPARE(returnCode, 200);
+    QCOMPARE(responseObject["identifier"].toString(),
+             QString("10-al-1c-trxple"));
+  }
+}
+
+void WorkerThreads::payloadExceedingLimitTest() {
+  auto options = workerOptions();
+  options.maxBodySize = 4096;
+  test::api::MockApiServer apiServer{ test::api::MockApiServer::State::Normal,
+                                      options };
+  auto token = test::utils::loginUser(apiServer.url(), "admin");
+
+  auto cableType = test::utils::makeCableType(1, "abc");
+  cableType["comment"] = QString(8192, 'x');
+  auto [responseObject, returnCode, networkError] =
+      test::utils::makePostRequest(
+          test::utils::makeRequest(apiServer.url("/cable/type"), token),
+          QJsonDocument(cableType).toJson());
+  QCOMPARE(returnCode, 413);
+  QVERIFY(not apiServer.store().findByIdentifier("1-al-1c-trxple"));
+}
+
+QTEST_MAIN(WorkerThreads)
+#include "WorkerThreads.moc"
@@ -71,8 +71,8 @@ void TestLogin::loginTest() {
   QFETCH(QString, expectedToken);
 
   test::api::MockApiServer apiServer;
-  auto [response, error] = makeRequest(
-      QUrl(QString("http://localhost:8080/login/%1").arg(userrole)));
+  auto [response, error] =
+      makeRequest(apiServer.url(QString("/login/%1").arg(userrole)));
   QCOMPARE(error, QNetworkReply::NetworkError::NoError);
   QVERIFY(response.isObject());
   QVERIFY(response.object().contains("jwtToken"));
@@ -1,135 +1,338 @@
 #include "utils.h"
 
-namespace test::utils {
-  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
-  makeGetRequest(const QNetworkRequest& request) {
-
-    QNetworkAccessManager manager;
-
-    QNetworkReply* reply = manager.get(request);
-
-    // Set up a QEventLoop to wait for the reply finished signal
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-
-    loop.exec();
+#include "DefaultCableType.h"
+
+#include <QCoreApplication>
+#include <QPromise>
+#include <QThread>
+#include <memory>
+
+namespace {
+  thread_local std::unique_ptr<test::utils::Client> threadLocalClient;
+
+  /*
+   * Client of main thread must not outlive QCoreApplication,
+   * thread local storage of main thread is released only after it.
+   */
+  void releaseMainThreadClient() {
+    threadLocalClient.reset();
+  }
 
+  test::utils::Response readReply(QNetworkReply* reply) {
     auto replyBytes = reply->readAll();
     QJsonDocument replyData = QJsonDocument::fromJson(replyBytes);
-    auto result = std::make_tuple(
+    return std::make_tuple(
         replyData.object(),
         reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute)
             .toInt(),
         reply->error());
+  }
 
-    // Clean up
-    reply->deleteLater();
+  QNetworkReply* send(test::utils::Client& client,
+                      const test::utils::Request& request) {
+    auto& manager = client.manager();
+    auto networkRequest = client.prepare(request.request);
+
+    // Only requests sent as known operations are pipelined by Qt
+    if ("GET" == request.verb) {
+      return manager.get(networkRequest);
+    }
+    if ("POST" == request.verb) {
+      return manager.post(networkRequest, request.data);
+    }
+    if ("PUT" == request.verb) {
+      return manager.put(networkRequest, request.data);
+    }
+    if ("DELETE" == request.verb) {
+      return manager.deleteResource(networkRequest);
+    }
+    return manager.sendCustomRequest(
+        networkRequest, request.verb, request.data);
+  }
 
-    return result;
+  test::utils::Response waitForResponse(test::utils::Client& client,
+                                        const test::utils::Request& request) {
+    return test::utils::waitForResults(
+               test::utils::sendRequest(client, request))
+        .front();
   }
+} // namespace
 
-  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
-  makePostRequest(const QNetworkRequest& request, const QByteArray& data) {
+namespace test::utils {
+  Client::Client()
+    : Client(Options{}) { }
+
+  Client::Client(Options options)
+    : m_options(options) {
+    QObject::connect(
+        &m_manager,
+        &QNetworkAccessManager::finished,
+        &m_manager,
+        [this](QNetworkReply* reply) {
+          // Qt drops Content-Length of responses it decompresses
+          auto length = reply->attribute(
+              QNetworkRequest::OriginalContentLengthAttribute);
+          if (not length.isValid()) {
+            length = reply->header(QNetworkRequest::ContentLengthHeader);
+          }
+          m_bodyBytesReceived += length.toULongLong();
+        });
+  }
 
-    QNetworkAccessManager manager;
+  QNetworkAccessManager& Client::manager() noexcept {
+    return m_manager;
+  }
 
-    QNetworkReply* reply = manager.post(request, data);
+  QNetworkRequest Client::prepare(QNetworkRequest request) const {
+    request.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute,
+                         m_options.pipelining);
+    // Qt advertises and decodes compression unless Accept-Encoding is set
+    if (not m_options.compression) {
+      request.setRawHeader("Accept-Encoding", "identity");
+    }
+    return request;
+  }
 
-    // Set up a QEventLoop to wait for the reply finished signal
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+  void Client::clearConnections() {
+    m_manager.clearConnectionCache();
+  }
 
-    loop.exec();
+  quint64 Client::bodyBytesReceived() const noexcept {
+    return m_bodyBytesReceived;
+  }
 
-    auto replyBytes = reply->readAll();
-    QJsonDocument replyData = QJsonDocument::fromJson(replyBytes);
-    auto result = std::make_tuple(
-        replyData.object(),
-        reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute)
-            .toInt(),
-        reply->error());
+  Client& threadClient() {
+    if (not threadLocalClient) {
+      threadLocalClient = std::make_unique<Client>();
 
-    // Clean up
-    reply->deleteLater();
+      auto* application = QCoreApplication::instance();
+      if (application and QThread::currentThread() == application->thread()) {
+        qAddPostRoutine(releaseMainThreadClient);
+      }
+    }
+    return *threadLocalClient;
+  }
+
+  QFuture<Response> sendRequest(Client& client, const Request& request) {
+    return sendBatch(client, { request });
+  }
+
+  QFuture<Response> sendBatch(Client& client, const QList<Request>& requests) {
+    auto promise = std::make_shared<QPromise<Response>>();
+    auto future = promise->future();
+    auto pending = std::make_shared<qsizetype>(requests.size());
+
+    promise->start();
+    promise->setProgressRange(0, static_cast<int>(requests.size()));
+    if (requests.isEmpty()) {
+      promise->finish();
+      return future;
+    }
+
+    for (qsizetype index = 0; index < requests.size(); ++index) {
+      auto* reply = send(client, requests[index]);
+      QObject::connect(
+          reply,
+          &QNetworkReply::finished,
+          reply,
+          [reply, promise, pending, index, total = requests.size()] {
+            promise->addResult(readReply(reply), static_cast<int>(index));
+            promise->setProgressValue(static_cast<int>(total - --*pending));
+            if (0 == *pending) {
+              promise->finish();
+            }
+
+            // Clean up
+            reply->deleteLater();
+          });
+    }
+
+    return future;
+  }
+
+  QNetworkRequest makeRequest(QUrl url,
+                              const QString& token,
+                              const QUrlQuery& query) {
+    if (not query.isEmpty()) {
+      url.setQuery(query);
+    }
+    QNetworkRequest request(url);
+    if (not token.isEmpty()) {
+      request.setRawHeader("Authorization", token.toLocal8Bit());
+    }
+    request.setHeader(QNetworkRequest::ContentTypeHeader,
+                      QString("application/json"));
+    return request;
+  }
+
+  QJsonObject makeCableType(int index, const QString& customerCode) {
+    auto cableType =
+        QJsonDocument::fromJson(test::api::defaultCableTypeData).object();
+    cableType.remove("id");
+    cableType["identifier"] = QString("%1-al-1c-trxple").arg(index);
+    cableType["catid"] = 1000000 + index;
+    if (not customerCode.isEmpty()) {
+      cableType["customer"] = QJsonObject{
+        { "id", "5f3bc9e2502422053e08f9f1" },
+        { "code", customerCode }
+      };
+    }
+    return cableType;
+  }
 
-    return result;
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeGetRequest(const QNetworkRequest& request) {
+    return makeGetRequest(threadClient(), request);
+  }
+
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeGetRequest(Client& client, const QNetworkRequest& request) {
+    return waitForResponse(client, { "GET", request });
+  }
+
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makePostRequest(const QNetworkRequest& request, const QByteArray& data) {
+    return makePostRequest(threadClient(), request, data);
+  }
+
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makePostRequest(Client& client,
+                  const QNetworkRequest& request,
+                  const QByteArray& data) {
+    return waitForResponse(client, { "POST", request, data });
   }
 
   std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
   makePutRequest(const QNetworkRequest& request, const QByteArray& data) {
+    return makePutRequest(threadClient(), request, data);
+  }
 
-    QNetworkAccessManager manager;
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makePutRequest(Client& client,
+                 const QNetworkRequest& request,
+                 const QByteArray& data) {
+    return waitForResponse(client, { "PUT", request, data });
+  }
 
-    QNetworkReply* reply = manager.put(request, data);
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeDeleteRequest(const QNetworkRequest& request) {
+    return makeDeleteRequest(threadClient(), request);
+  }
 
-    // Set up a QEventLoop to wait for the reply finished signal
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeDeleteRequest(Client& client, const QNetworkRequest& request) {
+    return waitForResponse(client, { "DELETE", request });
+  }
 
-    loop.exec();
+  NdjsonResponse makeNdjsonPostRequest(const QNetworkRequest& request,
+                                       const QList<QJsonObject>& objects) {
+    return makeNdjsonPostRequest(threadClient(), request, objects);
+  }
 
-    auto replyBytes = reply->readAll();
-    QJsonDocument replyData = QJsonDocument::fromJson(replyBytes);
-    auto result = std::make_tuple(
-        replyData.object(),
+  NdjsonResponse makeNdjsonPostRequest(Client& client,
+                                       const QNetworkRequest& request,
+                                       const QList<QJsonObject>& objects) {
+    QByteArray data;
+    for (const auto& object : objects) {
+      data += QJsonDocument(object).toJson(QJsonDocument::Compact);
+      data += '\n';
+    }
+
+    auto* reply = send(client, { "POST", request, data });
+    if (not reply->isFinished()) {
+      QEventLoop loop;
+      QObject::connect(
+          reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+      loop.exec();
+    }
+
+    QList<QJsonObject> lines;
+    for (const auto& line : reply->readAll().split('\n')) {
+      if (not line.trimmed().isEmpty()) {
+        lines.append(QJsonDocument::fromJson(line).object());
+      }
+    }
+    auto statusCode =
         reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute)
-            .toInt(),
-        reply->error());
-
-    // Clean up
+            .toInt();
+    auto error = reply->error();
     reply->deleteLater();
 
-    return result;
+    return std::make_tuple(lines, statusCode, error);
   }
 
-  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
-  makeDeleteRequest(const QNetworkRequest& request) {
+  std::optional<QString> TokenCache::find(const QString& userRole) {
+    std::lock_guard lock{ m_mutex };
+    auto entry = m_entries.find(userRole);
+    if (entry == m_entries.end()) {
+      ++m_misses;
+      return std::nullopt;
+    }
+
+    if (entry->second.expiresAt <= Clock::now()) {
+      m_entries.erase(entry);
+      ++m_misses;
+      return std::nullopt;
+    }
+
+    ++m_hits;
+    return entry->second.token;
+  }
 
-    QNetworkAccessManager manager;
+  void TokenCache::store(const QString& userRole, QString token) {
+    std::lock_guard lock{ m_mutex };
+    m_entries.insert_or_assign(
+        userRole, Entry{ std::move(token), Clock::now() + m_timeToLive });
+  }
 
-    QNetworkReply* reply = manager.deleteResource(request);
+  void TokenCache::invalidate(const QString& userRole) {
+    std::lock_guard lock{ m_mutex };
+    m_entries.erase(userRole);
+  }
 
-    // Set up a QEventLoop to wait for the reply finished signal
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
+  void TokenCache::invalidateAll() {
+    std::lock_guard lock{ m_mutex };
+    m_entries.clear();
+  }
 
-    loop.exec();
+  void TokenCache::setTimeToLive(std::chrono::milliseconds timeToLive) {
+    std::lock_guard lock{ m_mutex };
+    m_timeToLive = timeToLive;
+  }
 
-    auto replyBytes = reply->readAll();
-    QJsonDocument replyData = QJsonDocument::fromJson(replyBytes);
-    auto result = std::make_tuple(
-        replyData.object(),
-        reply->attribute(QNetworkRequest::Attribute::HttpStatusCodeAttribute)
-            .toInt(),
-        reply->error());
+  quint64 TokenCache::hits() const noexcept {
+    return m_hits;
+  }
 
-    // Clean up
-    reply->deleteLater();
+  quint64 TokenCache::misses() const noexcept {
+    return m_misses;
+  }
+
+  TokenCache& tokenCache() {
+    static TokenCache cache;
+    return cache;
+  }
 
-    return result;
+  QString loginUser(const QUrl& baseUrl, const QString& userRole) {
+    return loginUser(threadClient(), baseUrl, userRole);
   }
 
-  QString loginUser(const QString& userRole) {
-    QNetworkAccessManager manager;
+  QString
+  loginUser(Client& client, const QUrl& baseUrl, const QString& userRole) {
+    if (auto token = tokenCache().find(userRole)) {
+      return *token;
+    }
 
     QNetworkRequest request(
-        QUrl(QString("http://localhost:8080/login/%1").arg(userRole)));
+        QUrl(QString("%1/login/%2").arg(baseUrl.toString(), userRole)));
     request.setHeader(QNetworkRequest::ContentTypeHeader,
                       QString("application/json"));
-    QNetworkReply* reply = manager.get(request);
 
-    // Set up a QEventLoop to wait for the reply finished signal
-    QEventLoop loop;
-    QObject::connect(reply, &QNetworkReply::finished, &loop, &QEventLoop::quit);
-
-    loop.exec();
-
-    auto replyBytes = reply->readAll();
-    QJsonDocument response = QJsonDocument::fromJson(replyBytes);
-    auto token = response.object()["jwtToken"].toString();
-
-    // Clean up
-    reply->deleteLater();
+    auto [response, statusCode, error] = makeGetRequest(client, request);
+    auto token = response.value("jwtToken").toString();
+    if (not token.isEmpty()) {
+      tokenCache().store(userRole, token);
+    }
     return token;
   }
 } // namespace test::utils
@@ -1,24 +1,218 @@
 #pragma once
 #include <QEventLoop>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QObject>
+#include <QUrlQuery>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 
 namespace test::utils {
 
+  /*
+   * Long living HTTP client context.
+   * Keeps HTTP/1.1 connections alive between requests made through it,
+   * so requests to the same API Mock don't pay for connection setup.
+   * Must be used from thread it was created on.
+   */
+  class Client {
+
+  public:
+    struct Options {
+      /*
+       * Allows sending requests to API Mock without waiting
+       * for responses to previous ones on the same connection.
+       */
+      bool pipelining = false;
+
+      /*
+       * Advertises gzip and deflate in Accept-Encoding,
+       * compressed responses are decoded transparently.
+       */
+      bool compression = true;
+    };
+
+    Client();
+    explicit Client(Options options);
+    ~Client() = default;
+
+    QNetworkAccessManager& manager() noexcept;
+
+    /*
+     * Applies client options to request.
+     */
+    QNetworkRequest prepare(QNetworkRequest request) const;
+
+    /*
+     * Drops kept alive connections, e.g. after API Mock was restarted.
+     */
+    void clearConnections();
+
+    /*
+     * Response body bytes received as sent by API Mock,
+     * i.e. compressed ones for compressed responses.
+     */
+    quint64 bodyBytesReceived() const noexcept;
+
+  private:
+    QNetworkAccessManager m_manager;
+    Options m_options;
+    quint64 m_bodyBytesReceived = 0;
+  };
+
+  /*
+   * Client owned by calling thread, created on first use.
+   * Used by request helpers which don't take client explicitly.
+   */
+  Client& threadClient();
+
+  using Response = std::tuple<QJsonObject, int, QNetworkReply::NetworkError>;
+
+  struct Request {
+    QByteArray verb;
+    QNetworkRequest request;
+    QByteArray data = {};
+  };
+
+  /*
+   * Sends request without waiting for response.
+   * Future is fulfilled by event loop of calling thread.
+   */
+  QFuture<Response> sendRequest(Client& client, const Request& request);
+
+  /*
+   * Sends all requests at once, responses are reported as they arrive,
+   * with the same index request has in batch.
+   * Note that client opens at most 6 connections to the same API Mock,
+   * further requests are queued or pipelined if client allows it.
+   */
+  QFuture<Response> sendBatch(Client& client, const QList<Request>& requests);
+
+  /*
+   * Runs event loop of calling thread until all results are ready.
+   */
+  template <typename T>
+  QList<T> waitForResults(const QFuture<T>& future) {
+    if (not future.isFinished()) {
+      QFutureWatcher<T> watcher;
+      QEventLoop loop;
+      QObject::connect(
+          &watcher, &QFutureWatcherBase::finished, &loop, &QEventLoop::quit);
+      watcher.setFuture(future);
+      loop.exec();
+    }
+    return future.results();
+  }
+
+  /*
+   * JSON request to url with query, authorized by token unless it is empty.
+   */
+  QNetworkRequest makeRequest(QUrl url,
+                              const QString& token,
+                              const QUrlQuery& query = {});
+
+  /*
+   * Cable type API Mock is seeded with, made distinct by index:
+   * identifier "<index>-al-1c-trxple" and catid 1000000 + index.
+   * Id is removed, so API Mock assigns one, customer code is replaced
+   * unless empty.
+   */
+  QJsonObject makeCableType(int index, const QString& customerCode = {});
+
   std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
   makeGetRequest(const QNetworkRequest& request);
 
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeGetRequest(Client& client, const QNetworkRequest& request);
+
   std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
   makePostRequest(const QNetworkRequest& request, const QByteArray& data);
 
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makePostRequest(Client& client,
+                  const QNetworkRequest& request,
+                  const QByteArray& data);
+
   std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
   makePutRequest(const QNetworkRequest& request, const QByteArray& data);
 
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makePutRequest(Client& client,
+                 const QNetworkRequest& request,
+                 const QByteArray& data);
+
   std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
   makeDeleteRequest(const QNetworkRequest& request);
 
-  QString loginUser(const QString& userRole);
+  std::tuple<QJsonObject, int, QNetworkReply::NetworkError>
+  makeDeleteRequest(Client& client, const QNetworkRequest& request);
+
+  using NdjsonResponse =
+      std::tuple<QList<QJsonObject>, int, QNetworkReply::NetworkError>;
+
+  /*
+   * Sends objects as newline delimited JSON body,
+   * response is read as newline delimited JSON as well.
+   * Response which is a single JSON object (e.g. error) gives one line.
+   */
+  NdjsonResponse makeNdjsonPostRequest(const QNetworkRequest& request,
+                                       const QList<QJsonObject>& objects);
+
+  NdjsonResponse makeNdjsonPostRequest(Client& client,
+                                       const QNetworkRequest& request,
+                                       const QList<QJsonObject>& objects);
+
+  /*
+   * Process wide cache of tokens returned by API Mock login endpoint,
+   * keyed by user role. Every API Mock issues the same token for role,
+   * so tokens are shared by all of them, whatever port they listen on.
+   * Safe to use from multiple threads.
+   */
+  class TokenCache {
+
+  public:
+    static constexpr std::chrono::minutes defaultTimeToLive{ 10 };
+
+    std::optional<QString> find(const QString& userRole);
+    void store(const QString& userRole, QString token);
+    void invalidate(const QString& userRole);
+    void invalidateAll();
+    void setTimeToLive(std::chrono::milliseconds timeToLive);
+
+    quint64 hits() const noexcept;
+    quint64 misses() const noexcept;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+      QString token;
+      Clock::time_point expiresAt;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<QString, Entry> m_entries;
+    std::chrono::milliseconds m_timeToLive = defaultTimeToLive;
+    std::atomic<quint64> m_hits = 0;
+    std::atomic<quint64> m_misses = 0;
+  };
+
+  TokenCache& tokenCache();
+
+  /*
+   * Login helpers reuse tokens from tokenCache(),
+   * login request is sent only if token is not cached or expired.
+   */
+  QString loginUser(const QUrl& baseUrl, const QString& userRole);
+
+  QString
+  loginUser(Client& client, const QUrl& baseUrl, const QString& userRole);
 
 } // namespace test::utils